@@ -0,0 +1,148 @@
+// This file is part of nbind, copyright (C) 2014-2016 BusFaster Ltd.
+// Released under the MIT license, see LICENSE.
+
+// Bound code exercising every signature kind for measuring call overhead.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "nbind/api.h"
+
+void benchNopGlobal() {}
+
+class BenchCoord {
+
+public:
+
+	BenchCoord() : x(0), y(0) {}
+
+	BenchCoord(double x, double y) : x(x), y(y) {}
+
+	void toJS(nbind::cbOutput output) {
+		output(x, y);
+	}
+
+	double x;
+	double y;
+
+};
+
+class Bench {
+
+public:
+
+	Bench() : value(0) {}
+
+	Bench(int value) : value(value) {}
+
+	// Methods.
+
+	void nop() {}
+
+	int addInt(int a, int b) { return(a + b); }
+
+	double addDouble(double a, double b) { return(a + b); }
+
+	// Getter and setter.
+
+	int getValue() const { return(value); }
+	void setValue(int value) { this->value = value; }
+
+	// Static functions.
+
+	static void nopStatic() {}
+
+	static double addDoubleStatic(double a, double b) { return(a + b); }
+
+	static unsigned int strLength(const std::string &str) {
+		return(static_cast<unsigned int>(str.length()));
+	}
+
+	static unsigned int cStrLength(const char *str) {
+		unsigned int len = 0;
+		while(str[len]) ++len;
+		return(len);
+	}
+
+	static std::string getString() { return("benchmark"); }
+
+	static double sumVector(std::vector<double> list) {
+		double sum = 0;
+		for(double item : list) sum += item;
+		return(sum);
+	}
+
+	static std::vector<double> getVector() {
+		return(std::vector<double>(16, 1.5));
+	}
+
+	static unsigned int sumBuffer(nbind::Buffer buf) {
+		size_t length = buf.length();
+		unsigned char *data = buf.data();
+		unsigned int sum = 0;
+
+		if(!data) return(0);
+
+		for(size_t pos = 0; pos < length; ++pos) sum += data[pos];
+
+		return(sum);
+	}
+
+	static int64_t incrementInt64(int64_t x) { return(x + 1); }
+
+	static double callCallback(nbind::cbFunction &callback, double x) {
+		return(callback.call<double>(x));
+	}
+
+	static BenchCoord passCoord(BenchCoord coord) {
+		return(BenchCoord(coord.y, coord.x));
+	}
+
+	static Bench *getInstance() {
+		static Bench instance(42);
+		return(&instance);
+	}
+
+	int value;
+
+};
+
+#include "nbind/nbind.h"
+
+#ifdef NBIND_CLASS
+
+NBIND_CLASS(BenchCoord) {
+	construct<double, double>();
+}
+
+NBIND_CLASS(Bench) {
+	construct<>();
+	construct<int>();
+
+	method(nop);
+	method(addInt);
+	method(addDouble);
+
+	getset(getValue, setValue);
+
+	method(nopStatic);
+	method(addDoubleStatic);
+	method(strLength);
+	method(cStrLength);
+	method(getString);
+	method(sumVector);
+	method(getVector);
+	method(getVector, "getVectorTyped", nbind::TypedArray());
+	method(sumBuffer);
+	method(incrementInt64);
+	method(callCallback);
+	method(passCoord);
+	method(getInstance);
+}
+
+NBIND_GLOBAL() {
+	function(benchNopGlobal);
+}
+
+#endif
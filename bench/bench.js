@@ -0,0 +1,208 @@
+// This file is part of nbind, copyright (C) 2014-2016 BusFaster Ltd.
+// Released under the MIT license, see LICENSE.
+
+// Measure per-call overhead of each binding signature kind.
+// Run from bench/v8 or bench/em after building the bench addon:
+//
+//   node ../bench.js [--json file] [--baseline file] [--save-baseline]
+//                    [--threshold 0.25] [--time 200] [--filter regexp]
+//
+// Results are printed in ns/call and optionally written as JSON.
+// With a baseline file, cases slower than baseline * (1 + threshold)
+// are reported as regressions and the process exits with status 1.
+
+var fs = require('fs');
+var path = require('path');
+var nbind = require('..');
+
+var options = {
+	json: null,
+	baseline: path.resolve(__dirname, 'baseline.json'),
+	saveBaseline: false,
+	threshold: 0.25,
+	time: 200,
+	samples: 5,
+	filter: null
+};
+
+function parseArgs(argv) {
+	for(var num = 0; num < argv.length; ++num) {
+		var arg = argv[num];
+
+		switch(arg) {
+			case '--json':          options.json = argv[++num]; break;
+			case '--baseline':      options.baseline = path.resolve(argv[++num]); break;
+			case '--save-baseline': options.saveBaseline = true; break;
+			case '--threshold':     options.threshold = +argv[++num]; break;
+			case '--time':          options.time = +argv[++num]; break;
+			case '--samples':       options.samples = +argv[++num]; break;
+			case '--filter':        options.filter = new RegExp(argv[++num]); break;
+			default:
+				throw(new Error('Unknown option ' + arg));
+		}
+	}
+}
+
+function BenchCoord(x, y) {
+	this.x = x;
+	this.y = y;
+}
+
+BenchCoord.prototype.fromJS = function(output) {
+	output(this.x, this.y);
+};
+
+/** Return a list of benchmark cases. Each case returns a function
+  * calling the binding once per invocation. */
+
+function makeCases(lib) {
+	var Bench = lib.Bench;
+	var obj = new Bench(1);
+	var shortStr = 'hello';
+	var longStr = new Array(257).join('x');
+	var list = [];
+	var typedList = new Float64Array(16);
+	var coord = new BenchCoord(1, 2);
+	var buf = new Buffer(64);
+	var nop = function(x) { return(x); };
+
+	for(var num = 0; num < 16; ++num) list.push(num);
+	typedList.set(list);
+	buf.fill(1);
+
+	return([
+		{ name: 'function.nop', run: function() { lib.benchNopGlobal(); } },
+		{ name: 'static.nop', run: function() { Bench.nopStatic(); } },
+		{ name: 'static.double', run: function() { return(Bench.addDoubleStatic(1.5, 2.5)); } },
+		{ name: 'method.nop', run: function() { obj.nop(); } },
+		{ name: 'method.int', run: function() { return(obj.addInt(1, 2)); } },
+		{ name: 'method.double', run: function() { return(obj.addDouble(1.5, 2.5)); } },
+		{ name: 'getter', run: function() { return(obj.value); } },
+		{ name: 'setter', run: function() { obj.value = 2; } },
+		{ name: 'constructor.empty', run: function() { return(new Bench()); } },
+		{ name: 'constructor.int', run: function() { return(new Bench(3)); } },
+		{ name: 'string.arg.short', run: function() { return(Bench.strLength(shortStr)); } },
+		{ name: 'string.arg.long', run: function() { return(Bench.strLength(longStr)); } },
+		{ name: 'cstring.arg', run: function() { return(Bench.cStrLength(shortStr)); } },
+		{ name: 'string.return', run: function() { return(Bench.getString()); } },
+		{ name: 'vector.arg', run: function() { return(Bench.sumVector(list)); } },
+		{ name: 'vector.arg.typed', run: function() { return(Bench.sumVector(typedList)); } },
+		{ name: 'vector.return', run: function() { return(Bench.getVector()); } },
+		{ name: 'vector.return.typed', run: function() { return(Bench.getVectorTyped()); } },
+		{ name: 'buffer.arg', run: function() { return(Bench.sumBuffer(buf)); } },
+		{ name: 'int64', run: function() { return(Bench.incrementInt64(4294967296)); } },
+		{ name: 'callback', run: function() { return(Bench.callCallback(nop, 1)); } },
+		{ name: 'value.roundtrip', run: function() { return(Bench.passCoord(coord)); } },
+		{ name: 'pointer.return', run: function() { return(Bench.getInstance()); } }
+	]);
+}
+
+var now = process.hrtime ? function() {
+	var t = process.hrtime();
+	return(t[0] * 1e9 + t[1]);
+} : function() {
+	return(Date.now() * 1e6);
+};
+
+/** Run func repeatedly for about options.time milliseconds per sample.
+  * Return the median of samples in nanoseconds per call. */
+
+function measure(func) {
+	var count = 1;
+	var elapsed = 0;
+	var target = options.time * 1e6;
+	var samples = [];
+	var num;
+
+	// Warm up and find an iteration count filling the time budget.
+
+	while(elapsed < target / 10) {
+		count *= 2;
+		var start = now();
+		for(num = 0; num < count; ++num) func();
+		elapsed = now() - start;
+	}
+
+	count = Math.max(1, Math.ceil(count * target / elapsed));
+
+	for(var sample = 0; sample < options.samples; ++sample) {
+		var start = now();
+		for(num = 0; num < count; ++num) func();
+		samples.push((now() - start) / count);
+	}
+
+	samples.sort(function(a, b) { return(a - b); });
+
+	return(samples[samples.length >> 1]);
+}
+
+function pad(str, len) {
+	while(str.length < len) str += ' ';
+	return(str);
+}
+
+function main() {
+	parseArgs(process.argv.slice(2));
+
+	var binding = nbind.init();
+	var backend = binding.binary.type;
+	var lib = binding.lib;
+
+	binding.bind('BenchCoord', BenchCoord);
+	if(binding.toggleLightGC) binding.toggleLightGC(true);
+
+	var result = {
+		backend: backend,
+		node: process.versions.node,
+		date: new Date().toISOString(),
+		results: {}
+	};
+
+	var baselineAll = {};
+	var baseline = null;
+
+	if(fs.existsSync(options.baseline)) {
+		baselineAll = JSON.parse(fs.readFileSync(options.baseline, 'utf-8'));
+		baseline = baselineAll[backend] || null;
+	}
+
+	var regressions = [];
+
+	makeCases(lib).forEach(function(spec) {
+		if(options.filter && !options.filter.test(spec.name)) return;
+
+		var ns = measure(spec.run);
+		var line = pad(spec.name, 24) + pad(ns.toFixed(1), 10) + 'ns/call';
+
+		result.results[spec.name] = +ns.toFixed(2);
+
+		if(baseline && baseline[spec.name]) {
+			var ratio = ns / baseline[spec.name];
+
+			line += '  ' + (ratio >= 1 ? '+' : '') + ((ratio - 1) * 100).toFixed(1) + '%';
+
+			if(ratio > 1 + options.threshold) {
+				line += '  REGRESSION';
+				regressions.push(spec.name);
+			}
+		}
+
+		console.log(line);
+	});
+
+	if(options.json) {
+		fs.writeFileSync(options.json, JSON.stringify(result, null, '\t') + '\n');
+	}
+
+	if(options.saveBaseline) {
+		baselineAll[backend] = result.results;
+		fs.writeFileSync(options.baseline, JSON.stringify(baselineAll, null, '\t') + '\n');
+	}
+
+	if(regressions.length) {
+		console.error('Regressions: ' + regressions.join(', '));
+		process.exitCode = 1;
+	}
+}
+
+main();
@@ -0,0 +1,14 @@
+{
+	"includes": [
+		"../auto-top.gypi"
+	],
+
+	"targets": [
+		{
+			"includes": [
+				"../auto.gypi",
+				"../bench.gypi"
+			]
+		}
+	]
+}
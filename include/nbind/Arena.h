@@ -0,0 +1,208 @@
+// This file is part of nbind, copyright (C) 2014-2016 BusFaster Ltd.
+// Released under the MIT license, see LICENSE.
+
+// This file handles arenas, which hold objects constructed from JavaScript
+// inside a binding.withArena scope and destroy them all when it closes.
+
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+namespace nbind {
+
+// Specialize for classes whose objects constructed from JavaScript
+// should be placed in the current arena, if any, like:
+// template<> struct ArenaAllocated<Foo> : public std::true_type {};
+
+template <class Bound>
+struct ArenaAllocated : public std::false_type {};
+
+class Arena {
+
+public:
+
+	static NBIND_CONSTEXPR size_t slabSize = 64 * 1024;
+
+	Arena() {}
+
+	Arena(const Arena &) = delete;
+	Arena &operator=(const Arena &) = delete;
+
+	~Arena() { release(); }
+
+	// Bump allocate memory from the current slab.
+	// Requests larger than a quarter slab get their own.
+	// Returns nullptr if out of memory in asm.js, otherwise throws.
+
+	void *allocate(size_t size, size_t align) {
+		if(size + align > slabSize / 4) {
+			char *data = addLargeSlab(size + align);
+
+			return(data ? alignPtr(data, align) : nullptr);
+		}
+
+		char *ptr = nullptr;
+
+		if(!slabList.empty()) ptr = alignPtr(slabList.back().data + used, align);
+
+		if(ptr == nullptr || ptr + size > slabList.back().data + slabSize) {
+			if(!addSlab(slabSize)) return(nullptr);
+			ptr = alignPtr(slabList.back().data, align);
+		}
+
+		used = ptr + size - slabList.back().data;
+
+		return(ptr);
+	}
+
+	// Call finalize(ptr) when the arena is released.
+
+	void addFinalizer(void *ptr, void (*finalize)(void *)) {
+		finalizerList.push_back(Finalizer { ptr, finalize });
+	}
+
+	// Returns nullptr if out of memory in asm.js.
+
+	template <class Bound, typename... Args>
+	Bound *make(Args&&... args) {
+		void *mem = allocate(sizeof(Bound), alignof(Bound));
+
+		if(mem == nullptr) return(nullptr);
+
+		Bound *ptr = ::new(mem) Bound(std::forward<Args>(args)...);
+
+		addFinalizer(ptr, &destruct<Bound>);
+
+		return(ptr);
+	}
+
+	bool owns(const void *ptr) const {
+		const char *pos = static_cast<const char *>(ptr);
+
+		for(auto &slab : slabList) {
+			if(pos >= slab.data && pos < slab.data + slab.size) return(true);
+		}
+
+		return(false);
+	}
+
+	// Destroy all objects in reverse order of creation and free their memory.
+
+	void release() {
+		for(auto finalizer = finalizerList.rbegin(); finalizer != finalizerList.rend(); ++finalizer) {
+			finalizer->finalize(finalizer->ptr);
+		}
+
+		finalizerList.clear();
+
+		for(auto &slab : slabList) free(slab.data);
+
+		slabList.clear();
+		used = 0;
+	}
+
+	// Arenas for nested scopes, innermost last.
+
+	static Arena *getCurrent() {
+		auto &stack = getStack();
+
+		return(stack.empty() ? nullptr : stack.back());
+	}
+
+	static void enter() {
+		getStack().push_back(new Arena());
+	}
+
+	static void leave() {
+		auto &stack = getStack();
+
+		if(stack.empty()) return;
+
+		delete(stack.back());
+		stack.pop_back();
+	}
+
+private:
+
+	struct Slab {
+		char *data;
+		size_t size;
+	};
+
+	struct Finalizer {
+		void *ptr;
+		void (*finalize)(void *);
+	};
+
+	template <class Bound>
+	static void destruct(void *ptr) {
+		static_cast<Bound *>(ptr)->~Bound();
+	}
+
+	static char *alignPtr(char *ptr, size_t align) {
+		uintptr_t addr = reinterpret_cast<uintptr_t>(ptr);
+
+		return(ptr + (((addr + align - 1) & ~(align - 1)) - addr));
+	}
+
+	// asm.js is compiled without exceptions, so report failure by returning nullptr.
+
+	static char *outOfMemory() {
+#		if defined(__EMSCRIPTEN__)
+			return(nullptr);
+#		else
+			throw(std::bad_alloc());
+#		endif
+	}
+
+	char *addSlab(size_t size) {
+		char *data = static_cast<char *>(malloc(size));
+
+		if(data == nullptr) return(outOfMemory());
+
+		slabList.push_back(Slab { data, size });
+		used = 0;
+
+		return(data);
+	}
+
+	// Slabs for large objects are inserted before the current slab,
+	// so it stays available for further small objects.
+
+	char *addLargeSlab(size_t size) {
+		if(slabList.empty()) {
+			// No current slab, so mark this one full.
+			if(!addSlab(size)) return(nullptr);
+			used = slabSize;
+
+			return(slabList.back().data);
+		}
+
+		char *data = static_cast<char *>(malloc(size));
+
+		if(data == nullptr) return(outOfMemory());
+
+		slabList.insert(slabList.end() - 1, Slab { data, size });
+
+		return(data);
+	}
+
+	static std::vector<Arena *> &getStack() {
+		static thread_local std::vector<Arena *> stack;
+
+		return(stack);
+	}
+
+	std::vector<Slab> slabList;
+	std::vector<Finalizer> finalizerList;
+
+	// Bytes used in the last slab.
+	size_t used = 0;
+
+};
+
+} // namespace
@@ -17,6 +17,42 @@ struct SuperClassSpec {
 	void *(&upcast)(void *);
 };
 
+#if defined(BUILDING_NODE_EXTENSION)
+
+// JavaScript objects related to a bound class. Each thread running JavaScript
+// (the main thread and every worker_threads worker) has its own V8 isolate,
+// so it gets its own copy.
+
+struct ClassState {
+	Nan::Persistent<v8::FunctionTemplate> constructorTemplate;
+	/** Template for wrapping pointers returned from C++, bypassing the constructor. */
+	Nan::Persistent<v8::ObjectTemplate> instanceTemplate;
+	Nan::Persistent<v8::FunctionTemplate> superTemplate;
+	Nan::Persistent<v8::ObjectTemplate> storageTemplate;
+
+	/** Cached fromJS method and storage object for converting value objects. */
+	ConverterCache valueCache;
+
+	Nan::Persistent<v8::ObjectTemplate> fieldTemplate;
+	Nan::Persistent<v8::Function> fieldConstructor;
+	Nan::Persistent<v8::Object> valuePrototype;
+
+	// This has to be a pointer instead of a member object so the
+	// destructor won't get called. Otherwise NanCallback's destructor
+	// segfaults when freeing V8 resources because the surrounding
+	// object gets destroyed after the V8 engine.
+
+	cbFunction *valueConstructorJS = nullptr;
+
+	/** Live wrappers of the class in this isolate. */
+	LiveStats liveStats;
+
+	/** Constructor templates have been exported to this isolate. */
+	bool ready = false;
+};
+
+#endif // BUILDING_NODE_EXTENSION
+
 // Templated singleton class for each C++ class accessible from Node.js.
 // Stores their information defined in static constructors, until the Node.js
 // plugin is initialized.
@@ -47,6 +83,8 @@ public:
 
 	const char *getName() const { return(name); }
 
+	size_t getSize() const { return(size); }
+
 	std::forward_list<SuperClassSpec> &getSuperClassList() {
 		return(superClassList);
 	}
@@ -106,9 +144,80 @@ public:
 	/** Handler to wrap object pointers instantiated in C++ for use in JavaScript. */
 	jsMethod *wrapPtr;
 
-	Nan::Persistent<v8::FunctionTemplate> constructorTemplate;
-	Nan::Persistent<v8::FunctionTemplate> superTemplate;
-	Nan::Persistent<v8::ObjectTemplate> storageTemplate;
+	// State of the class in the V8 isolate running on the current thread.
+
+	ClassState &getState() {
+		static thread_local std::vector<std::unique_ptr<ClassState>> stateList;
+
+		if(stateNum >= stateList.size()) stateList.resize(stateNum + 1);
+
+		std::unique_ptr<ClassState> &state = stateList[stateNum];
+
+		if(!state) state.reset(new ClassState());
+
+		return(*state);
+	}
+
+	// Template for wrapping pointers returned from C++. Instantiates the
+	// class constructor first if the class was registered lazily.
+	// Empty if the class is not bound in the current thread.
+
+	v8::Local<v8::ObjectTemplate> getInstanceTemplate();
+
+	// Fields listed in NBIND_CLASS, used for converting value objects
+	// directly instead of calling toJS and fromJS.
+
+	void addField(FieldBase *field) {
+		fieldList.push_back(field);
+	}
+
+	const std::vector<FieldBase *> &getFieldList() const { return(fieldList); }
+
+	// Template for JavaScript objects created from value objects with fields.
+	// The properties are declared in advance so they get stored in-object
+	// and all instances share the same hidden class.
+
+	v8::Local<v8::ObjectTemplate> getFieldTemplate() {
+		Nan::Persistent<v8::ObjectTemplate> &fieldTemplate = getState().fieldTemplate;
+
+		if(fieldTemplate.IsEmpty()) {
+			v8::Local<v8::ObjectTemplate> tmpl = Nan::New<v8::ObjectTemplate>();
+
+			for(auto *field : fieldList) tmpl->Set(field->getKey(), Nan::Undefined());
+
+			fieldTemplate.Reset(tmpl);
+		}
+
+		return(Nan::New(fieldTemplate));
+	}
+
+	// Constructor for JavaScript objects created from value objects with
+	// fields, when a JavaScript value class is bound. Its instance template
+	// declares the fields and its prototype is the value class prototype,
+	// so instances start out with the right hidden class and prototype
+	// instead of having the prototype changed afterwards.
+	// Empty if no JavaScript value class is bound.
+
+	v8::Local<v8::Function> getFieldConstructor() {
+		ClassState &state = getState();
+
+		if(state.fieldConstructor.IsEmpty()) {
+			if(state.valuePrototype.IsEmpty()) return(v8::Local<v8::Function>());
+
+			v8::Local<v8::FunctionTemplate> constructorTemplate = Nan::New<v8::FunctionTemplate>();
+			v8::Local<v8::ObjectTemplate> tmpl = constructorTemplate->InstanceTemplate();
+
+			for(auto *field : fieldList) tmpl->Set(field->getKey(), Nan::Undefined());
+
+			v8::Local<v8::Function> func = Nan::GetFunction(constructorTemplate).ToLocalChecked();
+
+			Nan::Set(func, Nan::New<v8::String>("prototype").ToLocalChecked(), Nan::New(state.valuePrototype));
+
+			state.fieldConstructor.Reset(func);
+		}
+
+		return(Nan::New(state.fieldConstructor));
+	}
 
 #endif // BUILDING_NODE_EXTENSION
 
@@ -122,6 +231,35 @@ public:
 	// fast, in-object properties:
 	// http://jayconrod.com/posts/52/a-tour-of-v8-object-representation
 
+#if defined(BUILDING_NODE_EXTENSION)
+
+	void setValueConstructorJS(cbFunction &func) {
+		ClassState &state = getState();
+
+		if(state.valueConstructorJS != nullptr) delete(state.valueConstructorJS);
+		state.valueConstructorJS = new cbFunction(func);
+
+		v8::Local<v8::Value> proto;
+
+		if(
+			Nan::Get(func.getJsFunction(), Nan::New<v8::String>("prototype").ToLocalChecked()).ToLocal(&proto) &&
+			proto->IsObject()
+		) {
+			state.valuePrototype.Reset(proto.As<v8::Object>());
+		} else {
+			state.valuePrototype.Reset();
+		}
+
+		state.fieldConstructor.Reset();
+	}
+
+	cbFunction *getValueConstructorJS() { return(getState().valueConstructorJS); }
+
+	bool isReady() { return(getState().ready); }
+	void setReady() { getState().ready = true; }
+
+#else
+
 	void setValueConstructorJS(cbFunction &func) {
 		if(valueConstructorJS != nullptr) delete(valueConstructorJS);
 		valueConstructorJS = new cbFunction(func);
@@ -129,6 +267,11 @@ public:
 
 	cbFunction *getValueConstructorJS() const { return(valueConstructorJS); }
 
+	bool isReady() { return(ready); }
+	void setReady() { ready = true; }
+
+#endif // BUILDING_NODE_EXTENSION
+
 	void *upcastStep(BindClassBase &dst, void *ptr) {
 		if(&dst == this) return(ptr);
 
@@ -144,9 +287,6 @@ public:
 	void visit() { visited = true; }
 	void unvisit() { visited = false; }
 
-	bool isReady() { return(ready); }
-	void setReady() { ready = true; }
-
 protected:
 
 	TYPEID idList[2];
@@ -155,6 +295,9 @@ protected:
 
 	const char *name;
 
+	/** sizeof the C++ class, for estimating memory used by instances. */
+	size_t size;
+
 	std::forward_list<SuperClassSpec> superClassList;
 	unsigned int superClassCount = 0;
 
@@ -163,10 +306,24 @@ protected:
 
 	jsMethod *deleter;
 
+#if defined(BUILDING_NODE_EXTENSION)
+
+	std::vector<FieldBase *> fieldList;
+
+	// Index of this class in per-thread state lists.
+
+	static std::atomic<unsigned int> &getStateCount() {
+		static std::atomic<unsigned int> count(0);
+
+		return(count);
+	}
+
+	const unsigned int stateNum = getStateCount()++;
+
+#else
+
 	// This has to be a pointer instead of a member object so the
-	// destructor won't get called. Otherwise NanCallback's destructor
-	// segfaults when freeing V8 resources because the surrounding
-	// object gets destroyed after the V8 engine.
+	// destructor won't get called.
 
 	// Suitable JavaScript constructor called by a toJS C++ function
 	// when converting this object into a plain JavaScript object,
@@ -174,8 +331,13 @@ protected:
 
 	cbFunction *valueConstructorJS = nullptr;
 
+#endif // BUILDING_NODE_EXTENSION
+
 	bool visited = false;
+
+#if !defined(BUILDING_NODE_EXTENSION)
 	bool ready = false;
+#endif
 
 };
 
@@ -191,6 +353,7 @@ public:
 		idList[1] = Typer<Bound *>::makeID();
 
 		this->name = name;
+		this->size = sizeof(Bound);
 		this->policyNameList = DetectPolicies<Bound>::getPolicies();
 		this->deleter = reinterpret_cast<jsMethod *>(&BindClass::destroy);
 	}
@@ -232,6 +395,41 @@ public:
 
 #if defined(BUILDING_NODE_EXTENSION)
 
+inline const char *BindWrapperBase :: getClassName() {
+	return(bindClass.getName());
+}
+
+inline void BindWrapperBase :: addLive() {
+	LiveStats &stats = bindClass.getState().liveStats;
+
+	++stats.live;
+
+	if((flags & TypeFlags::refMask) == TypeFlags::isSharedPtr) ++stats.shared;
+	else ++stats.raw;
+
+	if(!!(flags & TypeFlags::isConst)) ++stats.constant;
+
+	stats.bytes += externalSize;
+
+	siteNum = AllocationSampler::sample(bindClass.getName());
+}
+
+inline void BindWrapperBase :: removeLive() {
+	LiveStats &stats = bindClass.getState().liveStats;
+
+	--stats.live;
+
+	if((flags & TypeFlags::refMask) == TypeFlags::isSharedPtr) --stats.shared;
+	else --stats.raw;
+
+	if(!!(flags & TypeFlags::isConst)) --stats.constant;
+
+	stats.bytes -= externalSize;
+
+	AllocationSampler::release(siteNum);
+	siteNum = 0;
+}
+
 template <class Bound>
 BindClassBase &BindWrapper<Bound> :: getBindClass() {
 	return(BindClass<Bound>::getInstance());
@@ -242,14 +440,14 @@ BindClassBase &BindWrapper<Bound> :: getBindClass() {
 
 template <class Bound>
 void BindWrapper<Bound> :: testInstance(v8::Local<v8::Object> arg) {
-	BindClassBase &bindClass = getBindClass();
+	Nan::Persistent<v8::FunctionTemplate> &superTemplate = getBindClass().getState().superTemplate;
 
-	if(bindClass.superTemplate.IsEmpty()) {
+	if(superTemplate.IsEmpty()) {
 		throw(std::runtime_error("Unbound type"));
 	}
 
 	if(
-		!Nan::New(bindClass.superTemplate)->HasInstance(arg) ||
+		!Nan::New(superTemplate)->HasInstance(arg) ||
 		arg->InternalFieldCount() != 1
 	) {
 		throw(std::runtime_error("Type mismatch"));
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
 #include <type_traits>
 #include <forward_list>
 #include <vector>
@@ -15,10 +17,15 @@
 
 #if defined(BUILDING_NODE_EXTENSION)
 
-#	include "v8/Caller.h"
+#	include "v8/Profile.h"
+#	include "v8/Caller.h"    // Needs Profile
+#	include "v8/Batch.h"
+#	include "v8/Async.h"
 #	include "signature/SignatureParam.h"
-#	include "signature/BaseSignature.h" // Needs Caller
+#	include "signature/BaseSignature.h" // Needs Caller, Batch and Async
 #	include "v8/Overloader.h" // Needs ArgStorage
+#	include "v8/ConverterCache.h"
+#	include "v8/Field.h"
 #	include "BindClass.h"     // Needs Overloader and BaseSignature
 #	include "v8/ValueObj.h"   // Needs BindClass
 #	include "v8/Int64.h"
@@ -260,6 +267,19 @@ public:
 		return(Overloaded<Args...>(*this));
 	}
 
+	// Field of a value object. Value objects with fields listed are converted
+	// by reading and writing the fields directly, without calling toJS or
+	// fromJS. In asm.js, fields are ignored and toJS and fromJS are used.
+
+	template <typename MemberType>
+	BindDefiner &field(const char *name, MemberType Bound::*member) {
+#		if defined(BUILDING_NODE_EXTENSION)
+			bindClass.addField(new Field<Bound, MemberType>(name, member));
+#		endif
+
+		return(*this);
+	}
+
 	template <typename GetterType, typename... Policies>
 	BindDefiner &property(
 		const char* name,
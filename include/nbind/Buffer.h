@@ -3,6 +3,15 @@
 
 #pragma once
 
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#if defined(_MSC_VER)
+#	include <malloc.h>
+#endif
+
 namespace nbind {
 
 class Buffer {
@@ -32,6 +41,42 @@ public:
 
 #endif
 
+	// Alignment of memory from alloc, suitable for SIMD instructions.
+	static constexpr size_t alignment = 64;
+
+	// Allocate memory owned by the buffer. Returning the buffer
+	// to JavaScript hands over the memory without copying.
+
+	static inline Buffer alloc(size_t len);
+
+	// Take ownership of memory, to be released by calling deleter.
+
+	template <typename Deleter>
+	static inline Buffer adopt(unsigned char *ptr, size_t len, Deleter deleter) {
+		Buffer result(ptr, len);
+
+		result.owner = std::shared_ptr<unsigned char>(ptr, deleter);
+
+		return(result);
+	}
+
+	// Take ownership of the contents of a byte container,
+	// like std::vector<unsigned char> or std::string.
+
+	template <typename Container>
+	static inline Buffer adopt(Container &&bytes) {
+		typedef typename std::decay<Container>::type Type;
+		Type *heap = new Type(std::forward<Container>(bytes));
+
+		return(adopt(
+			reinterpret_cast<unsigned char *>(
+				const_cast<typename Type::value_type *>(heap->data())
+			),
+			heap->size(),
+			[heap](unsigned char *) { delete heap; }
+		));
+	}
+
 	inline unsigned char *data() const { return(ptr); }
 
 	inline size_t length() const { return(len); }
@@ -42,9 +87,41 @@ private:
 
 	unsigned char *ptr;
 	size_t len;
+	// Memory owned by the buffer, if any.
+	std::shared_ptr<unsigned char> owner;
 	// Reference the JavaScript object to protect it from garbage collection.
 	External handle;
 
 };
 
+inline Buffer Buffer :: alloc(size_t len) {
+	void *ptr = nullptr;
+
+	// Allocate at least one byte to always get a valid pointer.
+
+#	if defined(_MSC_VER)
+		ptr = _aligned_malloc(len ? len : 1, alignment);
+#	else
+		if(posix_memalign(&ptr, alignment, len ? len : 1)) ptr = nullptr;
+#	endif
+
+	if(ptr == nullptr) {
+#		if defined(__EMSCRIPTEN__)
+			// asm.js is compiled without exceptions, so return an empty buffer.
+			NBIND_ERR("Out of memory");
+			return(Buffer());
+#		else
+			throw(std::bad_alloc());
+#		endif
+	}
+
+	return(adopt(static_cast<unsigned char *>(ptr), len, [](unsigned char *ptr) {
+#		if defined(_MSC_VER)
+			_aligned_free(ptr);
+#		else
+			free(ptr);
+#		endif
+	}));
+}
+
 } // namespace
@@ -0,0 +1,38 @@
+// This file is part of nbind, copyright (C) 2014-2016 BusFaster Ltd.
+// Released under the MIT license, see LICENSE.
+
+// This file handles choosing where objects get destroyed after
+// the garbage collector frees their last JavaScript wrapper.
+
+#pragma once
+
+#include <type_traits>
+
+namespace nbind {
+
+enum class DestroyMode {
+	/** Destroy inside the garbage collector, blocking JavaScript. */
+	immediate,
+	/** Destroy in a background thread. The destructor must be thread safe
+	  * and must not touch JavaScript values. */
+	inThread,
+	/** Destroy on the main thread, a few at a time between events. */
+	whenIdle
+};
+
+template <DestroyMode mode>
+struct DestroyModeType : public std::integral_constant<DestroyMode, mode> {};
+
+typedef DestroyModeType<DestroyMode::immediate> DestroyImmediately;
+typedef DestroyModeType<DestroyMode::inThread> DestroyInThread;
+typedef DestroyModeType<DestroyMode::whenIdle> DestroyWhenIdle;
+
+// Specialize for classes with expensive destructors, like:
+// template<> struct DestroyPolicy<Foo> : public DestroyInThread {};
+// Only objects owned by JavaScript through shared pointers are affected,
+// and only in Node.js. Calling free() still destroys them immediately.
+
+template <class Bound>
+struct DestroyPolicy : public DestroyImmediately {};
+
+} // namespace
@@ -65,7 +65,8 @@ enum class TypeFlags : uint32_t {
 	isCString = TypeFlagBase.kind * 7,
 	isString = TypeFlagBase.kind * 8,
 	isCallback = TypeFlagBase.kind * 9,
-	isOther = TypeFlagBase.kind * 10
+	isOther = TypeFlagBase.kind * 10,
+	isSpan = TypeFlagBase.kind * 11
 };
 
 inline TypeFlags operator& (TypeFlags a, TypeFlags b) {
@@ -148,12 +149,154 @@ struct Strict {
 
 	DEFINE_STRICT_BINDING_TYPE(std::string);
 
+#	if defined(NBIND_STRING_VIEW)
+		DEFINE_STRICT_BINDING_TYPE(std::string_view);
+#	endif
+
 	static const char *getName() {
 		static const char *name = "Strict";
 		return(name);
 	}
 };
 
+// Typed array policy
+
+template <typename ArgType>
+struct TypedArrayType {};
+
+struct TypedArray {
+	template <typename ArgType, typename Transformed>
+	struct Transform {
+		typedef Transformed Type;
+	};
+
+	template <typename MemberType, typename Transformed>
+	struct Transform<std::vector<MemberType>, Transformed> {
+		typedef TypedArrayType<Transformed> Type;
+	};
+
+	template <typename MemberType, size_t size, typename Transformed>
+	struct Transform<std::array<MemberType, size>, Transformed> {
+		typedef TypedArrayType<Transformed> Type;
+	};
+
+	static const char *getName() {
+		static const char *name = "TypedArray";
+		return(name);
+	}
+};
+
+// Bytes policy
+
+template <typename ArgType>
+struct BytesType {};
+
+struct Bytes {
+	template <typename ArgType, typename Transformed>
+	struct Transform {
+		typedef Transformed Type;
+	};
+
+	template <typename Transformed>
+	struct Transform<std::vector<unsigned char>, Transformed> {
+		typedef BytesType<Transformed> Type;
+	};
+
+	template <typename Transformed>
+	struct Transform<std::string, Transformed> {
+		typedef BytesType<Transformed> Type;
+	};
+
+	static const char *getName() {
+		static const char *name = "Bytes";
+		return(name);
+	}
+};
+
+// Static string policy
+
+template <typename ArgType>
+struct StaticStringType {};
+
+struct StaticString {
+	template <typename ArgType, typename Transformed>
+	struct Transform {
+		typedef Transformed Type;
+	};
+
+	template <typename Transformed>
+	struct Transform<const char *, Transformed> {
+		typedef StaticStringType<Transformed> Type;
+	};
+
+	template <typename Transformed>
+	struct Transform<const unsigned char *, Transformed> {
+		typedef StaticStringType<Transformed> Type;
+	};
+
+	static const char *getName() {
+		static const char *name = "StaticString";
+		return(name);
+	}
+};
+
+// Interned string policy
+
+template <typename ArgType>
+struct InternedType {};
+
+struct Interned {
+	template <typename ArgType, typename Transformed>
+	struct Transform {
+		typedef Transformed Type;
+	};
+
+	template <typename Transformed>
+	struct Transform<std::string, Transformed> {
+		typedef InternedType<Transformed> Type;
+	};
+
+	template <typename Transformed>
+	struct Transform<const char *, Transformed> {
+		typedef InternedType<Transformed> Type;
+	};
+
+	template <typename Transformed>
+	struct Transform<char *, Transformed> {
+		typedef InternedType<Transformed> Type;
+	};
+
+	template <typename Transformed>
+	struct Transform<const unsigned char *, Transformed> {
+		typedef InternedType<Transformed> Type;
+	};
+
+	template <typename Transformed>
+	struct Transform<unsigned char *, Transformed> {
+		typedef InternedType<Transformed> Type;
+	};
+
+	static const char *getName() {
+		static const char *name = "Interned";
+		return(name);
+	}
+};
+
+// Async policy. Runs functions in the libuv thread pool
+// and returns a Promise resolved with their return value.
+
+struct Async {
+	template <typename ArgType, typename Transformed>
+	struct Transform {
+		typedef Transformed Type;
+	};
+
+	static const char *getName() {
+		static const char *name = "Async";
+		return(name);
+	}
+};
+
 // Policy list
 
 template <typename...>
@@ -170,6 +313,21 @@ struct PolicyLister<PolicyListType<Policies...>> {
 	}
 };
 
+// Check if a policy list contains a policy.
+
+template <typename Policy, typename PolicyList>
+struct HasPolicy;
+
+template <typename Policy>
+struct HasPolicy<Policy, PolicyListType<>> : public std::false_type {};
+
+template <typename Policy, typename... Remaining>
+struct HasPolicy<Policy, PolicyListType<Policy, Remaining...>> : public std::true_type {};
+
+template <typename Policy, typename First, typename... Remaining>
+struct HasPolicy<Policy, PolicyListType<First, Remaining...>> :
+	public HasPolicy<Policy, PolicyListType<Remaining...>> {};
+
 // Policy autodetection part 1
 
 struct NoPolicy {
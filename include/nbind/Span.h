@@ -0,0 +1,64 @@
+// This file is part of nbind, copyright (C) 2014-2016 BusFaster Ltd.
+// Released under the MIT license, see LICENSE.
+
+#pragma once
+
+#include <type_traits>
+
+namespace nbind {
+
+// Typed view of numbers stored in a JavaScript typed array or ArrayBuffer,
+// or in C++ memory shown to JavaScript as a typed array without copying.
+
+template <typename ArgType>
+class Span {
+
+	static_assert(std::is_arithmetic<ArgType>::value, "Span members must be numbers");
+
+	friend struct BindingType<Span<ArgType>>;
+
+public:
+
+#if defined(BUILDING_NODE_EXTENSION)
+
+	Span(ArgType *ptr = nullptr, size_t len = 0) :
+		ptr(ptr), len(len) {}
+
+	Span(ArgType *ptr, size_t len, v8::Local<v8::Object> obj) :
+		ptr(ptr), len(len), handle(obj) {}
+
+#elif defined(__EMSCRIPTEN__)
+
+	Span(ArgType *ptr = nullptr, size_t len = 0, unsigned int num = 0) :
+		ptr(ptr), len(len), handle(num) {}
+
+#endif
+
+	inline ArgType *data() const { return(ptr); }
+
+	// Length in elements, not bytes.
+	inline size_t size() const { return(len); }
+	inline size_t length() const { return(len); }
+
+	inline ArgType &operator[](size_t num) const { return(ptr[num]); }
+
+	inline ArgType *begin() const { return(ptr); }
+	inline ArgType *end() const { return(ptr + len); }
+
+	inline void commit();
+
+private:
+
+	ArgType *ptr;
+	size_t len;
+	// Reference the JavaScript object to protect it from garbage collection.
+	External handle;
+
+};
+
+template <typename ArgType>
+using ArrayView = Span<ArgType>;
+
+NBIND_TYPER_PARAM(Span<ArgType>, span);
+
+} // namespace
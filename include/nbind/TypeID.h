@@ -18,6 +18,7 @@ enum class StructureType : unsigned char {
 	vector,
 	array,
 	callback,
+	span,
 	max
 };
 
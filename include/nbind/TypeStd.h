@@ -9,6 +9,10 @@
 #include <array>
 #include <functional>
 
+#if defined(NBIND_STRING_VIEW)
+#	include <string_view>
+#endif
+
 namespace nbind {
 
 NBIND_TYPER_PARAM(std::shared_ptr<ArgType>, shared);
@@ -28,6 +28,12 @@
 #	define NBIND_CONSTEXPR constexpr
 #endif
 
+// std::string_view is supported when compiling as C++17.
+
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#	define NBIND_STRING_VIEW
+#endif
+
 #include <utility>
 #include <cstdint>
 #include <cstring>
@@ -56,7 +62,7 @@ public:
 
 private:
 
-	static char *message;
+	static thread_local char *message;
 
 };
 
@@ -65,6 +71,8 @@ private:
 #include "TypeID.h"
 #include "TypeStd.h"
 #include "Policy.h"
+#include "Arena.h"
+#include "Destroy.h"
 
 #if defined(BUILDING_NODE_EXTENSION)
 
@@ -77,10 +85,15 @@ private:
 #	include "v8/ArgFromWire.h"
 #	include "v8/External.h"
 #	include "v8/Callback.h"
+#	include "v8/TypedArray.h"
 #	include "v8/BindingStd.h"
+#	include "v8/CallbackQueue.h"
+#	include "v8/StringCache.h"
 #	include "v8/StdFunction.h"
 #	include "Buffer.h"
 #	include "v8/Buffer.h"
+#	include "Span.h"
+#	include "v8/Span.h"
 
 #elif defined(__EMSCRIPTEN__)
 
@@ -93,8 +106,11 @@ private:
 #	include "em/External.h"
 #	include "em/Callback.h"
 #	include "em/BindingStd.h"
+#	include "em/CallbackQueue.h"
 #	include "em/StdFunction.h"
 #	include "Buffer.h"
 #	include "em/Buffer.h"
+#	include "Span.h"
+#	include "em/Span.h"
 
 #endif
@@ -150,6 +150,12 @@ struct BindingType<std::vector<MemberType>> {
 
 };
 
+// Arrays and vectors returned as typed arrays (TypedArray policy).
+// Conversion happens on the JavaScript side.
+
+template <typename ArgType>
+struct BindingType<TypedArrayType<ArgType>> : public BindingType<ArgType> {};
+
 // String.
 
 template<> struct BindingType<std::string> {
@@ -186,6 +192,15 @@ template<> struct BindingType<std::string> {
 
 template <> struct BindingType<StrictType<std::string>> : public BindingType<std::string> {};
 
+// Strings returned by the StaticString and Interned policies
+// are copied like any others.
+
+template <typename ArgType>
+struct BindingType<StaticStringType<ArgType>> : public BindingType<ArgType> {};
+
+template <typename ArgType>
+struct BindingType<InternedType<ArgType>> : public BindingType<ArgType> {};
+
 // String reference.
 
 template<> struct BindingType<const std::string &> {
@@ -218,4 +233,35 @@ struct ArgFromWire<PolicyList, const std::string &> {
 
 };
 
+#if defined(NBIND_STRING_VIEW)
+
+// String view, pointing to the temporary lalloc "stack frame"
+// valid until the function returns.
+
+template<> struct BindingType<std::string_view> {
+
+	typedef std::string_view Type;
+
+	typedef BindingType<std::string>::WireType WireType;
+
+	static inline Type fromWireType(WireType arg) {
+		return(std::string_view(arg->data, arg->length));
+	}
+
+	static inline WireType toWireType(Type arg) {
+		size_t length = arg.length();
+		WireType val = reinterpret_cast<WireType>(NBind::lalloc(sizeof(*val) + length - 1));
+
+		val->length = length;
+		std::copy(arg.begin(), arg.end(), val->data);
+
+		return(val);
+	}
+
+};
+
+template <> struct BindingType<StrictType<std::string_view>> : public BindingType<std::string_view> {};
+
+#endif // NBIND_STRING_VIEW
+
 } // namespace
@@ -23,10 +23,31 @@ template<> struct BindingType<Buffer> {
 		));
 	}
 
-	static inline WireType toWireType(Type arg) { return(nullptr); }
+	/** Copy the contents into the temporary lalloc "stack frame",
+	  * for JavaScript to copy into a Uint8Array. */
+
+	static inline WireType toWireType(Type arg) {
+		if(!arg.ptr) return(nullptr);
+
+		WireType val = reinterpret_cast<WireType>(NBind::lalloc(sizeof(*val) + arg.len));
+
+		val->length = arg.len;
+		val->data = reinterpret_cast<unsigned char *>(val + 1);
+		val->num = 0;
+
+		memcpy(val->data, arg.ptr, arg.len);
+
+		return(val);
+	}
 
 };
 
+// Byte containers returned as Uint8Array objects (Bytes policy).
+// Conversion happens on the JavaScript side.
+
+template <typename ArgType>
+struct BindingType<BytesType<ArgType>> : public BindingType<ArgType> {};
+
 inline void Buffer :: commit() {
 	EM_ASM_ARGS(
 		{_nbind.commitBuffer($0,$1,$2);},
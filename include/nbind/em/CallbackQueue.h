@@ -0,0 +1,102 @@
+// This file is part of nbind, copyright (C) 2014-2016 BusFaster Ltd.
+// Released under the MIT license, see LICENSE.
+
+// This file handles queuing calls to JavaScript callbacks.
+
+#pragma once
+
+#include <vector>
+#include <emscripten.h>
+
+namespace nbind {
+
+// asm.js has a single thread, so cbQueue only defers calls until
+// the current JavaScript code returns, with the same ordering and
+// coalescing as in Node.js.
+
+template <typename Payload>
+class cbQueue {
+
+public:
+
+	explicit cbQueue(const cbFunction &func, bool coalesce = false) :
+		state(new State(func, coalesce)) {}
+
+	cbQueue(const cbQueue &) = delete;
+	cbQueue &operator=(const cbQueue &) = delete;
+
+	~cbQueue() { state->close(); }
+
+	void post(Payload payload) { state->post(std::move(payload)); }
+
+private:
+
+	// State is freed by a pending flush, which may happen
+	// after the queue is destroyed.
+
+	class State {
+
+	public:
+
+		State(const cbFunction &func, bool coalesce) :
+			func(func), coalesce(coalesce) {}
+
+		void post(Payload &&payload) {
+			payloadList.push_back(std::move(payload));
+
+			if(!isScheduled) {
+				isScheduled = true;
+				emscripten_async_call(&State::flush, this, 0);
+			}
+		}
+
+		void close() {
+			isClosed = true;
+
+			if(!isScheduled) delete(this);
+		}
+
+	private:
+
+		static void flush(void *arg) {
+			State *state = static_cast<State *>(arg);
+			std::vector<Payload> list;
+
+			list.swap(state->payloadList);
+			state->isScheduled = false;
+
+			if(!state->isClosed) {
+				// Calls may post more payloads, scheduling another flush.
+				state->isScheduled = true;
+
+				if(state->coalesce) {
+					state->func(std::move(list));
+				} else {
+					for(auto &payload : list) state->func(std::move(payload));
+				}
+
+				state->isScheduled = !state->payloadList.empty();
+
+				if(state->isScheduled) {
+					emscripten_async_call(&State::flush, state, 0);
+					return;
+				}
+			}
+
+			if(state->isClosed) delete(state);
+		}
+
+		std::vector<Payload> payloadList;
+
+		cbFunction func;
+		bool coalesce;
+		bool isScheduled = false;
+		bool isClosed = false;
+
+	};
+
+	State *state;
+
+};
+
+} // namespace
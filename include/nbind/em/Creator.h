@@ -15,8 +15,22 @@ struct Creator {
 
 		WireType val = reinterpret_cast<WireType>(NBind::lalloc(sizeof(*val)));
 
-		val->boundUnsafe = new Bound(ArgFromWire<PolicyList, Args>(args).get(args)...);
-		val->boundShared = new std::shared_ptr<Bound>(val->boundUnsafe);
+		Arena *arena = ArenaAllocated<Bound>::value ? Arena::getCurrent() : nullptr;
+
+		Bound *ptr = nullptr;
+
+		// The arena owns the object, so the shared pointer must not delete it.
+		// If the arena is out of memory, fall back to the normal heap.
+
+		if(arena != nullptr) ptr = arena->template make<Bound>(ArgFromWire<PolicyList, Args>(args).get(args)...);
+
+		if(ptr != nullptr) {
+			val->boundUnsafe = ptr;
+			val->boundShared = new std::shared_ptr<Bound>(ptr, [](Bound *) {});
+		} else {
+			val->boundUnsafe = new Bound(ArgFromWire<PolicyList, Args>(args).get(args)...);
+			val->boundShared = new std::shared_ptr<Bound>(val->boundUnsafe);
+		}
 
 		return(val);
 	}
@@ -54,6 +54,10 @@ public:
 	static uintptr_t lalloc(size_t size);
 	static void lreset(unsigned int used, uintptr_t page);
 
+	static void enterArena();
+	static void leaveArena();
+	static bool arenaOwns(uintptr_t ptr);
+
 };
 
 } // namespace
@@ -0,0 +1,54 @@
+// This file is part of nbind, copyright (C) 2014-2016 BusFaster Ltd.
+// Released under the MIT license, see LICENSE.
+
+#pragma once
+
+namespace nbind {
+
+template <typename ArgType>
+struct BindingType<Span<ArgType>> {
+
+	typedef Span<ArgType> Type;
+
+	/** Same layout as the Buffer wire type. Length is in elements.
+	  * num is zero if JavaScript passed a view of the heap directly. */
+
+	typedef struct {
+		uint32_t length;
+		ArgType *data;
+		unsigned int num;
+	} *WireType;
+
+	static inline Type fromWireType(WireType arg) {
+		return(Type(
+			arg->data,
+			arg->length,
+			arg->num
+		));
+	}
+
+	/** JavaScript creates a typed array on the heap at the given address. */
+
+	static inline WireType toWireType(Type arg) {
+		WireType val = reinterpret_cast<WireType>(NBind::lalloc(sizeof(*val)));
+
+		val->length = arg.size();
+		val->data = arg.data();
+		val->num = 0;
+
+		return(val);
+	}
+
+};
+
+template <typename ArgType>
+inline void Span<ArgType> :: commit() {
+	if(!handle.getNum()) return;
+
+	EM_ASM_ARGS(
+		{_nbind.commitBuffer($0,$1,$2);},
+		handle.getNum(), ptr, len * sizeof(ArgType)
+	);
+}
+
+} // namespace
@@ -47,6 +47,22 @@ public:
 		return(policyNameList);
 	}
 
+	// Caller invoked directly by the JavaScript engine, if the signature
+	// allows bypassing the generic callback wrapper. Otherwise null.
+
+	funcPtr getDirectCaller() const { return(directCaller); }
+	void setDirectCaller(funcPtr directCaller) {
+		this->directCaller = directCaller;
+	}
+
+	// Caller for batch calls over columns of arguments, if supported.
+	// Otherwise null.
+
+	funcPtr getBatchCaller() const { return(batchCaller); }
+	void setBatchCaller(funcPtr batchCaller) {
+		this->batchCaller = batchCaller;
+	}
+
 	// A value constructor pointer is included in each signature,
 	// but only used for constructors.
 
@@ -58,6 +74,15 @@ public:
 	template<typename MethodType>
 	static inline funcPtr getDirect(MethodType func) { return(nullptr); }
 
+#if defined(BUILDING_NODE_EXTENSION) && defined(NBIND_PROFILE)
+
+	// Profile entry of each function with this signature.
+
+	unsigned int getProfileNum(unsigned int num) const { return(profileNumList[num]); }
+	void addProfileNum(unsigned int profileNum) { profileNumList.push_back(profileNum); }
+
+#endif // BUILDING_NODE_EXTENSION && NBIND_PROFILE
+
 private:
 
 	const SignatureType type;
@@ -66,6 +91,12 @@ private:
 	const TYPEID *typeList;
 	const unsigned int arity;
 	funcPtr valueConstructor;
+	funcPtr directCaller = nullptr;
+	funcPtr batchCaller = nullptr;
+
+#if defined(BUILDING_NODE_EXTENSION) && defined(NBIND_PROFILE)
+	std::vector<unsigned int> profileNumList;
+#endif
 
 };
 
@@ -85,7 +116,10 @@ public:
 		PolicyLister<PolicyList>::getNameList(),
 		listTypes<ReturnType, Args...>(),
 		sizeof...(Args)
-	) {}
+	) {
+		setDirectCaller(Signature::getDirectCaller());
+		setBatchCaller(Signature::getBatchCaller());
+	}
 
 	// Making the instance a direct class member fails on some platforms.
 	// Maybe it registers the signature too early.
@@ -115,6 +149,14 @@ public:
 
 	};
 
+	// Signatures able to skip the generic callback wrapper override this.
+
+	static funcPtr getDirectCaller() { return(nullptr); }
+
+	// Signatures callable in batches override this.
+
+	static funcPtr getBatchCaller() { return(nullptr); }
+
 	static const MethodInfo &getMethod(unsigned int num) {
 		return(getInstance().funcVect[num]);
 	}
@@ -125,22 +167,41 @@ public:
 
 		funcVect.emplace_back(func, flags | TypeFlags::isMethod);
 
+#		if defined(BUILDING_NODE_EXTENSION) && defined(NBIND_PROFILE)
+			getInstance().addProfileNum(ProfileScope::addEntry());
+#		endif
+
 		return(funcVect.size() - 1);
 	}
 
 #if defined(BUILDING_NODE_EXTENSION)
 
-	// Specialize static caller functions defined in Caller.h.
-
-	typedef Caller<
-		ReturnType,
-		typename emscripten::internal::MapWithIndex<
-			PolicyList,
-			TypeList,
-			ArgFromWire,
-			Args...
-		>::type
-	> CallWrapper;
+	// Specialize static caller functions defined in Caller.h,
+	// or Async.h for functions returning a Promise.
+
+	typedef typename std::conditional<
+		HasPolicy<Async, PolicyList>::value,
+		AsyncCaller<
+			ReturnType,
+			typename emscripten::internal::MapWithIndex<
+				PolicyList,
+				TypeList,
+				AsyncArg,
+				Args...
+			>::type,
+			PolicyList
+		>,
+		Caller<
+			ReturnType,
+			typename emscripten::internal::MapWithIndex<
+				PolicyList,
+				TypeList,
+				ArgFromWire,
+				Args...
+			>::type,
+			PolicyList
+		>
+	>::type CallWrapper;
 
 	typedef Checker<
 		typename emscripten::internal::MapWithIndex<
@@ -151,9 +212,11 @@ public:
 		>::type
 	> CheckWrapper;
 
+	static constexpr bool isPrimitive = IsPrimitiveSignature<PolicyList, ReturnType, Args...>::value;
+
 	template <typename NanArgs>
 	static bool typesAreValid(NanArgs &args) {
-		return(CheckWrapper::typesAreValid(args));
+		return(isPrimitive || CheckWrapper::typesAreValid(args));
 	}
 
 	template <typename NanArgs>
@@ -166,6 +229,17 @@ public:
 		return(args.Length() == arity);
 	}
 
+#	if NODE_MODULE_VERSION >= 14
+
+		// Direct calls from V8 skip Nan's wrapper.
+
+		static bool arityIsValid(const v8::FunctionCallbackInfo<v8::Value> &args) {
+			static constexpr decltype(args.Length()) arity = sizeof...(Args);
+			return(args.Length() == arity);
+		}
+
+#	endif
+
 	template <typename Value>
 	static bool arityIsValid(const Nan::PropertyCallbackInfo<Value> &args) {
 		return(true);
@@ -190,19 +264,33 @@ public:
 		return(nullptr);
 	}
 
+	// Profile entry of a function, if NBIND_PROFILE is defined.
+
+	static unsigned int getProfileEntry(unsigned int num) {
+#		if defined(NBIND_PROFILE)
+			return(getInstance().getProfileNum(num));
+#		else
+			return(0);
+#		endif
+	}
+
 	template <typename Bound, typename V8Args, typename NanArgs>
 	static void callInnerSafely(V8Args &args, NanArgs &nanArgs, unsigned int methodNum) {
+		ProfileScope profile(getProfileEntry(methodNum));
+		TraceSpan trace(nanArgs);
 		Bound *target = nullptr;
 
 		if(!arityIsValid(nanArgs)) {
 			// TODO: When function is overloaded, this test could be skipped...
 
 			std::string msg = "Wrong number of arguments, expected " + std::to_string(sizeof...(Args));
+			profile.fail();
 			Nan::ThrowError(msg.c_str());
 			return;
 		}
 
 		if(!Signature::typesAreValid(args)) {
+			profile.fail();
 			Nan::ThrowError(Signature::getTypeError(args));
 			return;
 		}
@@ -214,18 +302,207 @@ public:
 
 			Status::clearError();
 			Signature::callInner(method, args, nanArgs, target);
-			if(Status::getError() != nullptr) Nan::ThrowError(Status::getError());
+
+			if(Status::getError() != nullptr) {
+				profile.fail();
+				Nan::ThrowError(Status::getError());
+			}
 		} catch(const cbException &ex) {
 			// A JavaScript exception is already heading up the stack.
+			profile.fail();
 		} catch(const std::exception &ex) {
 			const char *message = Status::getError();
 
 			if(message == nullptr) message = ex.what();
 
+			profile.fail();
 			Nan::ThrowError(message);
 		}
 	}
 
+	// Batch calls to methods pass the target object as the first argument.
+
+	template <typename Bound>
+	static Bound *getBatchTarget(
+		const Nan::FunctionCallbackInfo<v8::Value> &nanArgs,
+		Bound *target,
+		TypeFlags flags
+	) {
+		if(!nanArgs[0]->IsObject()) throw(std::runtime_error("Batch call needs a target object"));
+
+		return(BindWrapper<Bound>::getBound(nanArgs[0].template As<v8::Object>(), flags));
+	}
+
+	static void *getBatchTarget(
+		const Nan::FunctionCallbackInfo<v8::Value> &nanArgs,
+		void *target,
+		TypeFlags flags
+	) {
+		return(nullptr);
+	}
+
+	// Call a function or method once for each row in columns of arguments,
+	// returning an array of the results. Numeric results are returned
+	// in a typed array.
+
+	template <typename Bound>
+	static void callBatchSafely(const Nan::FunctionCallbackInfo<v8::Value> &nanArgs, unsigned int methodNum) {
+		static constexpr int first = std::is_void<Bound>::value ? 0 : 1;
+		TraceSpan trace(nanArgs);
+		Bound *target = nullptr;
+
+		if(sizeof...(Args) == 0) {
+			Nan::ThrowError("Batch call needs argument columns");
+			return;
+		}
+
+		if(nanArgs.Length() != first + static_cast<int>(sizeof...(Args))) {
+			std::string msg = "Wrong number of arguments, expected " + std::to_string(first + sizeof...(Args));
+			Nan::ThrowError(msg.c_str());
+			return;
+		}
+
+		const MethodInfo &method = getMethod(methodNum);
+
+		try {
+			target = getBatchTarget(nanArgs, target, method.flags);
+
+			BatchArgs args(
+				first ? nanArgs[0].template As<v8::Object>() : nanArgs.This(),
+				sizeof...(Args)
+			);
+
+			int64_t length = args.setColumns(nanArgs, first);
+
+			if(length < 0) {
+				Nan::ThrowError("Batch argument columns differ in length");
+				return;
+			}
+
+			// Check types one column at a time before calling anything.
+
+			if(!CheckWrapper::checkColumns(args, static_cast<uint32_t>(length))) {
+				Nan::ThrowError(getTypeError(args));
+				return;
+			}
+
+			Status::clearError();
+
+			v8::Local<v8::Object> result;
+
+			if(callRows(
+				methodNum,
+				method,
+				args,
+				target,
+				static_cast<uint32_t>(length),
+				result,
+				static_cast<typename BatchResultType<PolicyList, ReturnType>::Type *>(nullptr)
+			)) {
+				nanArgs.GetReturnValue().Set(result);
+			}
+		} catch(const cbException &ex) {
+			// A JavaScript exception is already heading up the stack.
+		} catch(const std::exception &ex) {
+			const char *message = Status::getError();
+
+			if(message == nullptr) message = ex.what();
+
+			Nan::ThrowError(message);
+		}
+	}
+
+	// Call a batch storing results in a plain array.
+	// Return false if an error was thrown.
+
+	template <typename Bound>
+	static bool callRows(
+		unsigned int methodNum,
+		const MethodInfo &method,
+		BatchArgs &args,
+		Bound *target,
+		uint32_t length,
+		v8::Local<v8::Object> &output,
+		void *
+	) {
+		v8::Local<v8::Array> result = Nan::New<v8::Array>(length);
+
+		for(uint32_t row = 0; row < length; ++row) {
+			Nan::HandleScope scope;
+			ProfileScope profile(getProfileEntry(methodNum));
+
+			args.setRow(row);
+
+			WireType value;
+
+			try {
+				value = Signature::callValue(method, args, target);
+			} catch(...) {
+				profile.fail();
+				throw;
+			}
+
+			if(Status::getError() != nullptr) {
+				profile.fail();
+				Nan::ThrowError(Status::getError());
+				return(false);
+			}
+
+			Nan::Set(result, row, value);
+		}
+
+		output = result;
+		return(true);
+	}
+
+	// Call a batch storing numeric results directly in a typed array,
+	// without converting them to JavaScript values first.
+
+	template <typename Bound, typename ArrayType>
+	static bool callRows(
+		unsigned int methodNum,
+		const MethodInfo &method,
+		BatchArgs &args,
+		Bound *target,
+		uint32_t length,
+		v8::Local<v8::Object> &output,
+		ArrayType *
+	) {
+		typedef typename std::remove_cv<ReturnType>::type ValueType;
+
+		v8::Local<ArrayType> result = ArrayType::New(
+			v8::ArrayBuffer::New(v8::Isolate::GetCurrent(), length * sizeof(ValueType)),
+			0,
+			length
+		);
+
+		Nan::TypedArrayContents<ValueType> contents(result);
+		ValueType *data = *contents;
+
+		for(uint32_t row = 0; row < length; ++row) {
+			Nan::HandleScope scope;
+			ProfileScope profile(getProfileEntry(methodNum));
+
+			args.setRow(row);
+
+			try {
+				data[row] = Signature::callRaw(method, args, target);
+			} catch(...) {
+				profile.fail();
+				throw;
+			}
+
+			if(Status::getError() != nullptr) {
+				profile.fail();
+				Nan::ThrowError(Status::getError());
+				return(false);
+			}
+		}
+
+		output = result;
+		return(true);
+	}
+
 #endif // BUILDING_NODE_EXTENSION
 
 	// The funcVect vector cannot be moved to BaseSignature because it can contain pointers to
@@ -39,10 +39,14 @@ public:
 	> ConstructWrapper;
 
 	static void call(const Nan::FunctionCallbackInfo<v8::Value> &args) {
+		if(!Parent::typesAreValid(args)) throw(ArgTypeError());
+
 		ConstructWrapper::create(args);
 	}
 
 	static void createValue(ArgStorage &storage, const Nan::FunctionCallbackInfo<v8::Value> &args) {
+		if(!Parent::typesAreValid(args)) throw(ArgTypeError());
+
 		ConstructWrapper::createValue(storage, args);
 	}
 
@@ -29,14 +29,27 @@ public:
 
 #if defined(BUILDING_NODE_EXTENSION)
 
-	template <typename V8Args, typename NanArgs>
-	static void callInner(const typename Parent::MethodInfo &method, V8Args &args, NanArgs &nanArgs, void *) {
-		nanArgs.GetReturnValue().Set(Parent::CallWrapper::callFunction(
+	template <typename V8Args>
+	static WireType callValue(const typename Parent::MethodInfo &method, V8Args &args, void *) {
+		return(Parent::CallWrapper::callFunction(
+			method.func,
+			args
+		));
+	}
+
+	template <typename V8Args>
+	static ReturnType callRaw(const typename Parent::MethodInfo &method, V8Args &args, void *) {
+		return(Parent::CallWrapper::invokeFunction(
 			method.func,
 			args
 		));
 	}
 
+	template <typename V8Args, typename NanArgs>
+	static void callInner(const typename Parent::MethodInfo &method, V8Args &args, NanArgs &nanArgs, void *target) {
+		nanArgs.GetReturnValue().Set(callValue(method, args, target));
+	}
+
 	static void call(const Nan::FunctionCallbackInfo<v8::Value> &args) {
 		Parent::template callInnerSafely<void>(
 			args,
@@ -45,6 +58,38 @@ public:
 		);
 	}
 
+	static void callBatch(const Nan::FunctionCallbackInfo<v8::Value> &args) {
+		Parent::template callBatchSafely<void>(
+			args,
+			SignatureParam::get(args)->methodNum
+		);
+	}
+
+	static funcPtr getBatchCaller() {
+		return(reinterpret_cast<funcPtr>(callBatch));
+	}
+
+#	if NODE_MODULE_VERSION >= 14
+
+		// Signatures with only numeric and boolean types are called directly
+		// by V8 without type checks, skipping Nan's callback wrapper.
+
+		static void callDirect(const v8::FunctionCallbackInfo<v8::Value> &args) {
+			Parent::template callInnerSafely<void>(
+				args,
+				args,
+				SignatureParam::get(args)->methodNum
+			);
+		}
+
+		static funcPtr getDirectCaller() {
+			if(!Parent::isPrimitive) return(nullptr);
+
+			return(reinterpret_cast<funcPtr>(callDirect));
+		}
+
+#	endif
+
 #elif defined(__EMSCRIPTEN__)
 
 	static typename TypeTransformer<ReturnType, PolicyList>::Binding::WireType call(
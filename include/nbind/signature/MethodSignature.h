@@ -25,15 +25,29 @@ public:
 
 #if defined(BUILDING_NODE_EXTENSION)
 
-	template <typename V8Args, typename NanArgs>
-	static void callInner(const typename Parent::MethodInfo &method, V8Args &args, NanArgs &nanArgs, Bound *target) {
-		nanArgs.GetReturnValue().Set(Parent::CallWrapper::callMethod(
+	template <typename V8Args>
+	static WireType callValue(const typename Parent::MethodInfo &method, V8Args &args, Bound *target) {
+		return(Parent::CallWrapper::callMethod(
 			*target,
 			method.func,
 			args
 		));
 	}
 
+	template <typename V8Args>
+	static ReturnType callRaw(const typename Parent::MethodInfo &method, V8Args &args, Bound *target) {
+		return(Parent::CallWrapper::invokeMethod(
+			*target,
+			method.func,
+			args
+		));
+	}
+
+	template <typename V8Args, typename NanArgs>
+	static void callInner(const typename Parent::MethodInfo &method, V8Args &args, NanArgs &nanArgs, Bound *target) {
+		nanArgs.GetReturnValue().Set(callValue(method, args, target));
+	}
+
 	static void call(const Nan::FunctionCallbackInfo<v8::Value> &args) {
 		Parent::template callInnerSafely<Bound>(
 			args,
@@ -42,6 +56,38 @@ public:
 		);
 	}
 
+	static void callBatch(const Nan::FunctionCallbackInfo<v8::Value> &args) {
+		Parent::template callBatchSafely<Bound>(
+			args,
+			SignatureParam::get(args)->methodNum
+		);
+	}
+
+	static funcPtr getBatchCaller() {
+		return(reinterpret_cast<funcPtr>(callBatch));
+	}
+
+#	if NODE_MODULE_VERSION >= 14
+
+		// Signatures with only numeric and boolean types are called directly
+		// by V8 without type checks, skipping Nan's callback wrapper.
+
+		static void callDirect(const v8::FunctionCallbackInfo<v8::Value> &args) {
+			Parent::template callInnerSafely<Bound>(
+				args,
+				args,
+				SignatureParam::get(args)->methodNum
+			);
+		}
+
+		static funcPtr getDirectCaller() {
+			if(!Parent::isPrimitive) return(nullptr);
+
+			return(reinterpret_cast<funcPtr>(callDirect));
+		}
+
+#	endif
+
 #elif defined(__EMSCRIPTEN__)
 
 	static typename TypeTransformer<ReturnType, PolicyList>::Binding::WireType call(
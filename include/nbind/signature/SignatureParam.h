@@ -32,8 +32,26 @@ struct SignatureParam {
 		unsigned int setterNum;
 	};
 
+	// Names for trace events.
+
+	const char *className = nullptr;
+	const char *name = nullptr;
+
 };
 
+#if NODE_MODULE_VERSION >= 72
+
+template <typename InfoType>
+TraceSpan::TraceSpan(const InfoType &args) {
+	if(isEnabled()) {
+		SignatureParam *param = SignatureParam::get(args);
+
+		begin(param->className, param->name);
+	}
+}
+
+#endif // NODE_MODULE_VERSION
+
 #endif // BUILDING_NODE_EXTENSION
 
 } // namespace
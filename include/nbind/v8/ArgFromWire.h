@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <stdexcept>
+
 namespace nbind {
 
 // ArgFromWire converts JavaScript types into C++ types, usually with BindingType<>::fromWireType
@@ -10,6 +12,24 @@ namespace nbind {
 // FromWire is a struct, so wrappers for all objects can be constructed as function arguments,
 // and their actual values passed to the called function are returned by the get() function.
 // The wrappers go out of scope and are destroyed at the end of the function call.
+// Callers check the types of all arguments before converting any of them,
+// so a wrong argument stops the call before earlier arguments run fromJS
+// or allocate anything. Converting doesn't check them again.
+
+class ArgTypeError : public std::runtime_error {
+
+public:
+
+	ArgTypeError() : std::runtime_error("Type mismatch") {}
+
+};
+
+// Get an argument, already checked against the policies in PolicyList.
+
+template<typename PolicyList, size_t Index, typename ArgType, typename NanArgs>
+inline WireType checkedArg(const NanArgs &args) {
+	return(args[Index]);
+}
 
 // Handle most C++ types.
 
@@ -23,9 +43,123 @@ struct ArgFromWire {
 
 	template <typename NanArgs>
 	inline typename Transformed::Type get(const NanArgs &args) noexcept(false) {
-		return(Transformed::Binding::fromWireType(args[Index]));
+		return(Transformed::Binding::fromWireType(checkedArg<PolicyList, Index, ArgType>(args)));
+	}
+
+};
+
+// Decode a JavaScript string into UTF-8. Short strings are stored in a buffer
+// on the stack, so converting them needs no heap allocations. Strings with
+// only one-byte characters are copied as Latin-1 and expanded in place,
+// skipping V8's UTF-8 encoder.
+
+class StringBuffer {
+
+public:
+
+	static NBIND_CONSTEXPR size_t stackSize = 256;
+
+	explicit StringBuffer(WireType arg) {
+		v8::Local<v8::String> str = Nan::To<v8::String>(arg).ToLocalChecked();
+
+#		if NODE_MODULE_VERSION >= 14 // >= Node.js 0.12
+			if(str->IsOneByte()) decodeOneByte(str);
+			else decodeUtf8(str);
+#		else
+			Nan::Utf8String val(str);
+
+			len = val.length();
+			memcpy(reserve(len), *val, len);
+#		endif
+
+		ptr[len] = 0;
 	}
 
+	StringBuffer(const StringBuffer &) = delete;
+	StringBuffer &operator=(const StringBuffer &) = delete;
+
+	inline const char *data() const { return(ptr); }
+
+	inline size_t length() const { return(len); }
+
+private:
+
+	// Make room for count bytes and a terminating zero,
+	// keeping the first keep bytes of the previous contents.
+
+	char *reserve(size_t count, size_t keep = 0) {
+		if(count < stackSize) {
+			ptr = stackBuf;
+		} else {
+			char *heapPtr = new char[count + 1];
+
+			if(keep) memcpy(heapPtr, ptr, keep);
+
+			heapBuf.reset(heapPtr);
+			ptr = heapPtr;
+		}
+
+		return(ptr);
+	}
+
+#	if NODE_MODULE_VERSION >= 14 // >= Node.js 0.12
+
+	void decodeOneByte(v8::Local<v8::String> str) {
+		size_t count = str->Length();
+		uint8_t *buf = reinterpret_cast<uint8_t *>(reserve(count));
+		size_t extra = 0;
+
+#		if NODE_MODULE_VERSION >= 72 // >= Node.js 12
+			str->WriteOneByte(v8::Isolate::GetCurrent(), buf, 0, count, v8::String::NO_NULL_TERMINATION);
+#		else
+			str->WriteOneByte(buf, 0, count, v8::String::NO_NULL_TERMINATION);
+#		endif
+
+		// Latin-1 characters above 127 take 2 bytes in UTF-8.
+
+		for(size_t pos = 0; pos < count; ++pos) extra += buf[pos] >> 7;
+
+		len = count + extra;
+		if(!extra) return;
+
+		buf = reinterpret_cast<uint8_t *>(reserve(len, count));
+
+		// Expand backwards so the input isn't overwritten before it's read.
+
+		size_t out = len;
+
+		for(size_t pos = count; pos--;) {
+			uint8_t c = buf[pos];
+
+			if(c < 0x80) {
+				buf[--out] = c;
+			} else {
+				buf[--out] = 0x80 | (c & 0x3f);
+				buf[--out] = 0xc0 | (c >> 6);
+			}
+		}
+	}
+
+	void decodeUtf8(v8::Local<v8::String> str) {
+#		if NODE_MODULE_VERSION >= 72 // >= Node.js 12
+			v8::Isolate *isolate = v8::Isolate::GetCurrent();
+
+			len = str->Utf8Length(isolate);
+			str->WriteUtf8(isolate, reserve(len), len, nullptr, v8::String::NO_NULL_TERMINATION);
+#		else
+			len = str->Utf8Length();
+			str->WriteUtf8(reserve(len), len, nullptr, v8::String::NO_NULL_TERMINATION);
+#		endif
+	}
+
+#	endif // >= Node.js 0.12
+
+	char *ptr;
+	size_t len;
+
+	char stackBuf[stackSize];
+	std::unique_ptr<char[]> heapBuf;
+
 };
 
 // Handle char pointers, which will receive a C string representation of any JavaScript value.
@@ -34,16 +168,16 @@ template<typename PolicyList, size_t Index>
 struct ArgFromWire<PolicyList, Index, const char *> {
 
 	template <typename NanArgs>
-	ArgFromWire(const NanArgs &args) : val(Nan::To<v8::String>(args[Index]).ToLocalChecked()) {}
+	ArgFromWire(const NanArgs &args) : val(checkedArg<PolicyList, Index, const char *>(args)) {}
 
 	template <typename NanArgs>
 	inline const char *get(const NanArgs &args) {
-		return(*val);
+		return(val.data());
 	}
 
 	// RAII style storage for the string data.
 
-	Nan::Utf8String val;
+	StringBuffer val;
 
 };
 
@@ -53,16 +187,16 @@ template<typename PolicyList, size_t Index>
 struct ArgFromWire<PolicyList, Index, const unsigned char *> {
 
 	template <typename NanArgs>
-	ArgFromWire(const NanArgs &args) : val(Nan::To<v8::String>(args[Index]).ToLocalChecked()) {}
+	ArgFromWire(const NanArgs &args) : val(checkedArg<PolicyList, Index, const unsigned char *>(args)) {}
 
 	template <typename NanArgs>
 	inline const unsigned char *get(const NanArgs &args) {
-		return(reinterpret_cast<const unsigned char *>(*val));
+		return(reinterpret_cast<const unsigned char *>(val.data()));
 	}
 
 	// RAII style storage for the string data.
 
-	Nan::Utf8String val;
+	StringBuffer val;
 
 };
 
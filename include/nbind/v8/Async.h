@@ -0,0 +1,375 @@
+// This file is part of nbind, copyright (C) 2014-2016 BusFaster Ltd.
+// Released under the MIT license, see LICENSE.
+
+// This file handles functions bound with the Async policy. Their arguments
+// are converted on the main thread, the C++ code runs in the libuv thread
+// pool and the returned Promise settles back on the main thread.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace nbind {
+
+class cbFunction;
+
+template <typename Type>
+struct IsStdFunction : public std::false_type {};
+
+template <typename Signature>
+struct IsStdFunction<std::function<Signature>> : public std::true_type {};
+
+// AsyncArg converts an argument and keeps a copy of its value until the call
+// runs in another thread. Objects passed by reference get copied, while
+// objects passed by pointer are pinned.
+
+template<typename PolicyList, size_t Index, typename ArgType>
+struct AsyncArg {
+
+	typedef typename std::decay<ArgType>::type Type;
+
+	// Both kinds of callbacks call into JavaScript,
+	// which is impossible from the thread pool.
+
+	static_assert(
+		!std::is_same<Type, cbFunction>::value && !IsStdFunction<Type>::value,
+		"Callbacks cannot be passed to Async functions"
+	);
+
+	template <typename NanArgs>
+	AsyncArg(const NanArgs &args) :
+		val(ArgFromWire<PolicyList, Index, ArgType>(args).get(args)) {}
+
+	inline ArgType &&get() { return(std::forward<ArgType>(val)); }
+
+	Type val;
+
+};
+
+// Calling free() on an object passed by pointer, or leaving a binding.scope(),
+// must not destroy it while the call runs. Keep its shared pointer, like for
+// the target object. Wrappers of raw pointers have none.
+
+template<typename PolicyList, size_t Index, typename ArgType>
+struct AsyncArg<PolicyList, Index, ArgType *> {
+
+	template <typename NanArgs>
+	AsyncArg(const NanArgs &args) :
+		val(ArgFromWire<PolicyList, Index, ArgType *>(args).get(args)) {
+		if(val != nullptr) {
+			shared = node::ObjectWrap::Unwrap<BindWrapperBase>(
+				Nan::To<v8::Object>(args[Index]).ToLocalChecked()
+			)->getSharedBound();
+		}
+	}
+
+	inline ArgType *get() { return(val); }
+
+	ArgType *val;
+	std::shared_ptr<void> shared;
+
+};
+
+// C strings point to temporary storage, so copy their contents.
+
+template<typename PolicyList, size_t Index, typename ArgType>
+struct AsyncStringArg {
+
+	template <typename NanArgs>
+	AsyncStringArg(const NanArgs &args) {
+		ArgFromWire<PolicyList, Index, ArgType> arg(args);
+		ArgType ptr = arg.get(args);
+
+		isNull = ptr == nullptr;
+		if(!isNull) str = reinterpret_cast<const char *>(ptr);
+	}
+
+	inline ArgType get() {
+		if(isNull) return(nullptr);
+
+		return(reinterpret_cast<ArgType>(&str[0]));
+	}
+
+	std::string str;
+	bool isNull;
+
+};
+
+#define DEFINE_ASYNC_STRING_ARG(ArgType)                    \
+template<typename PolicyList, size_t Index>                 \
+struct AsyncArg<PolicyList, Index, ArgType> :               \
+	public AsyncStringArg<PolicyList, Index, ArgType> {     \
+	template <typename NanArgs>                             \
+	AsyncArg(const NanArgs &args) :                         \
+		AsyncStringArg<PolicyList, Index, ArgType>(args) {} \
+}
+
+DEFINE_ASYNC_STRING_ARG(const char *);
+DEFINE_ASYNC_STRING_ARG(char *);
+DEFINE_ASYNC_STRING_ARG(const unsigned char *);
+DEFINE_ASYNC_STRING_ARG(unsigned char *);
+
+#if defined(NBIND_STRING_VIEW)
+
+// String views point to temporary storage, so copy their contents.
+
+template<typename PolicyList, size_t Index>
+struct AsyncArg<PolicyList, Index, std::string_view> {
+
+	template <typename NanArgs>
+	AsyncArg(const NanArgs &args) :
+		str(ArgFromWire<PolicyList, Index, std::string_view>(args).get(args)) {}
+
+	inline std::string_view get() { return(str); }
+
+	std::string str;
+
+};
+
+#endif // NBIND_STRING_VIEW
+
+// AsyncResult stores the return value until it's converted on the main thread.
+
+template <typename ReturnType>
+struct AsyncResult {
+
+	template <class Task>
+	void call(Task &task) {
+		value.reset(new ReturnType(task.invoke()));
+	}
+
+	template <typename PolicyList>
+	WireType toWireType() {
+		return(TypeTransformer<ReturnType, PolicyList>::Binding::toWireType(std::move(*value)));
+	}
+
+	std::unique_ptr<ReturnType> value;
+
+};
+
+// References are returned as is, like in synchronous calls.
+
+template <typename ReturnType>
+struct AsyncResult<ReturnType &> {
+
+	template <class Task>
+	void call(Task &task) {
+		ptr = &task.invoke();
+	}
+
+	template <typename PolicyList>
+	WireType toWireType() {
+		return(TypeTransformer<ReturnType &, PolicyList>::Binding::toWireType(*ptr));
+	}
+
+	ReturnType *ptr = nullptr;
+
+};
+
+template <>
+struct AsyncResult<void> {
+
+	template <class Task>
+	void call(Task &task) {
+		task.invoke();
+	}
+
+	template <typename PolicyList>
+	WireType toWireType() {
+		return(Nan::Undefined());
+	}
+
+};
+
+#if NODE_MODULE_VERSION >= 46 // >= Node.js 4.0
+
+// Worker holding converted arguments for a single call.
+// Bound is void for functions not belonging to a class.
+
+template <typename ReturnType, typename PolicyList, typename MethodType, class Bound, typename... Args>
+class AsyncTask : public Nan::AsyncWorker, private Args... {
+
+public:
+
+	template <typename NanArgs>
+	AsyncTask(MethodType method, Bound *target, const NanArgs &args) :
+		Nan::AsyncWorker(nullptr), Args(args)..., method(method), target(target) {}
+
+#	if NODE_MODULE_VERSION >= 64 // >= Node.js 10
+		~AsyncTask() {
+			if(hasContext) node::EmitAsyncDestroy(v8::Isolate::GetCurrent(), asyncContext);
+		}
+#	endif
+
+	// Pin the JavaScript arguments and target object, so pointers
+	// to their contents stay valid while the call runs.
+
+	template <typename NanArgs>
+	void pin(const NanArgs &args) {
+		v8::Local<v8::Array> argList = Nan::New<v8::Array>(args.Length());
+
+		for(int num = 0; num < args.Length(); ++num) {
+			Nan::Set(argList, num, args[num]);
+		}
+
+		SaveToPersistent("args", argList);
+		SaveToPersistent("target", args.This());
+
+		pinTarget(args, target);
+	}
+
+	v8::Local<v8::Promise> makePromise() {
+		v8::Local<v8::Promise::Resolver> resolver = v8::Promise::Resolver::New(
+			Nan::GetCurrentContext()
+		).ToLocalChecked();
+
+		SaveToPersistent("resolver", resolver);
+
+#		if NODE_MODULE_VERSION >= 64 // >= Node.js 10
+			v8::Local<v8::Object> resource = Nan::New<v8::Object>();
+
+			SaveToPersistent("resource", resource);
+			asyncContext = node::EmitAsyncInit(v8::Isolate::GetCurrent(), resource, "nbind:Async");
+			hasContext = true;
+#		endif
+
+		return(resolver->GetPromise());
+	}
+
+	// Call a method.
+
+	template <class Target>
+	ReturnType invoke(Target *obj) {
+		return((obj->*method)(Args::get()...));
+	}
+
+	// Call a function not belonging to a class.
+
+	ReturnType invoke(void *) {
+		return((*method)(Args::get()...));
+	}
+
+	ReturnType invoke() { return(invoke(target)); }
+
+	// Runs in the thread pool, so must not touch any JavaScript values.
+
+	void Execute() override {
+		try {
+			result.call(*this);
+		} catch(const std::exception &ex) {
+			SetErrorMessage(ex.what());
+		} catch(...) {
+			SetErrorMessage("Unknown exception in Async function");
+		}
+	}
+
+	void HandleOKCallback() override {
+		v8::Local<v8::Value> value;
+
+		try {
+			value = result.template toWireType<PolicyList>();
+		} catch(const std::exception &ex) {
+			settle(Nan::Error(ex.what()), false);
+			return;
+		}
+
+		settle(value, true);
+	}
+
+	void HandleErrorCallback() override {
+		settle(Nan::Error(ErrorMessage()), false);
+	}
+
+private:
+
+	// Calling free() on the target, or leaving a binding.scope(), must not
+	// destroy the object while the call runs. Wrappers of raw pointers
+	// have no shared pointer and the object belongs to C++.
+
+	template <typename NanArgs, class Target>
+	void pinTarget(const NanArgs &args, Target *) {
+		targetShared = node::ObjectWrap::Unwrap<BindWrapperBase>(args.This())->getSharedBound();
+	}
+
+	template <typename NanArgs>
+	void pinTarget(const NanArgs &args, void *) {}
+
+	// Settle inside a callback scope, so .then handlers run
+	// when it closes, like after any other callback.
+
+	void settle(v8::Local<v8::Value> value, bool ok) {
+		v8::Local<v8::Promise::Resolver> resolver = GetFromPersistent("resolver").template As<v8::Promise::Resolver>();
+
+#		if NODE_MODULE_VERSION >= 64 // >= Node.js 10
+			node::CallbackScope scope(
+				v8::Isolate::GetCurrent(),
+				GetFromPersistent("resource").template As<v8::Object>(),
+				asyncContext
+			);
+#		endif
+
+		if(ok) resolver->Resolve(Nan::GetCurrentContext(), value).FromMaybe(false);
+		else resolver->Reject(Nan::GetCurrentContext(), value).FromMaybe(false);
+
+#		if NODE_MODULE_VERSION < 64 // < Node.js 10
+			v8::Isolate::GetCurrent()->RunMicrotasks();
+#		endif
+	}
+
+	MethodType method;
+	Bound *target;
+	std::shared_ptr<void> targetShared;
+
+#	if NODE_MODULE_VERSION >= 64 // >= Node.js 10
+		node::async_context asyncContext;
+		bool hasContext = false;
+#	endif
+
+	AsyncResult<ReturnType> result;
+
+};
+
+#endif // NODE_MODULE_VERSION >= 46
+
+// Replaces Caller for functions with the Async policy.
+// Returns a Promise instead of the converted return value.
+
+template<typename ReturnType, typename ArgList, typename PolicyList> struct AsyncCaller;
+
+template<typename ReturnType, typename... Args, typename PolicyList>
+struct AsyncCaller<ReturnType, TypeList<Args...>, PolicyList> {
+
+	template <class Bound, typename MethodType, typename NanArgs>
+	static WireType callMethod(Bound &target, MethodType method, NanArgs &args) noexcept(false) {
+		return(queue<Bound>(method, &target, args));
+	}
+
+	template <typename Function, typename NanArgs>
+	static WireType callFunction(Function func, NanArgs &args) noexcept(false) {
+		return(queue<void>(func, nullptr, args));
+	}
+
+	template <class Bound, typename MethodType, typename NanArgs>
+	static WireType queue(MethodType method, Bound *target, NanArgs &args) noexcept(false) {
+#		if NODE_MODULE_VERSION >= 46 // >= Node.js 4.0
+			// Note that constructing the arguments may throw.
+			auto *task = new AsyncTask<ReturnType, PolicyList, MethodType, Bound, Args...>(method, target, args);
+
+			task->pin(args);
+			v8::Local<v8::Promise> promise = task->makePromise();
+
+			Nan::AsyncQueueWorker(task);
+
+			return(promise);
+#		else
+			(void)method; (void)target; (void)args; // Silence compiler warnings about unused parameters.
+
+			throw(std::runtime_error("Async functions need Node.js 4.0 or newer"));
+#		endif
+	}
+
+};
+
+} // namespace
@@ -0,0 +1,121 @@
+// This file is part of nbind, copyright (C) 2014-2016 BusFaster Ltd.
+// Released under the MIT license, see LICENSE.
+
+// This file handles batch calls, which call a bound function once for
+// each element in columns of arguments, passed as arrays or typed arrays.
+// The JavaScript to C++ transition only happens once for the whole batch.
+
+#pragma once
+
+#include <vector>
+
+namespace nbind {
+
+// Arguments of a single call in a batch, usable in place of
+// Nan::FunctionCallbackInfo in Caller and ArgFromWire.
+
+class BatchArgs {
+
+public:
+
+	BatchArgs(v8::Local<v8::Object> target, unsigned int count) :
+		target(target), columnList(count), valueList(count) {}
+
+	// Check that all columns are arrays or typed arrays of equal length
+	// and return the length, or -1 if they're not.
+
+	template <typename NanArgs>
+	int64_t setColumns(const NanArgs &args, int first) {
+		int64_t length = -1;
+
+		for(unsigned int num = 0; num < columnList.size(); ++num) {
+			v8::Local<v8::Value> arg = args[first + num];
+			int64_t columnLength;
+
+			if(arg->IsArray()) {
+				columnLength = arg.As<v8::Array>()->Length();
+#			if NODE_MODULE_VERSION >= 14 // >= Node.js 0.12
+			} else if(arg->IsTypedArray()) {
+				columnLength = arg.As<v8::TypedArray>()->Length();
+				typedMask |= 1ULL << (num & 63);
+#			endif
+			} else return(-1);
+
+			if(length >= 0 && columnLength != length) return(-1);
+
+			length = columnLength;
+			columnList[num] = arg.As<v8::Object>();
+		}
+
+		return(length);
+	}
+
+	// Column holds only numbers.
+
+	inline bool isTyped(unsigned int num) const { return(num < 64 && (typedMask >> num) & 1); }
+
+	inline v8::Local<v8::Value> getCell(unsigned int num, uint32_t row) const {
+		return(Nan::Get(columnList[num], row).ToLocalChecked());
+	}
+
+	// Read arguments of a single call from each column.
+
+	void setRow(uint32_t row) {
+		for(unsigned int num = 0; num < columnList.size(); ++num) {
+			valueList[num] = Nan::Get(columnList[num], row).ToLocalChecked();
+		}
+	}
+
+	inline v8::Local<v8::Value> operator[](int num) const { return(valueList[num]); }
+
+	inline int Length() const { return(static_cast<int>(valueList.size())); }
+
+	inline v8::Local<v8::Object> This() const { return(target); }
+
+private:
+
+	v8::Local<v8::Object> target;
+
+	std::vector<v8::Local<v8::Object>> columnList;
+	std::vector<v8::Local<v8::Value>> valueList;
+
+	uint64_t typedMask = 0;
+
+};
+
+// Typed array for results of a batch call returning numbers, chosen by size
+// to match the heap views used in asm.js. Other results go in a plain array
+// (Type is void).
+
+template <bool isFloat, bool isSigned, size_t size>
+struct TypedArrayFor { typedef void Type; };
+
+#if NODE_MODULE_VERSION >= 14 // >= Node.js 0.12
+
+template <> struct TypedArrayFor<false, true,  1> { typedef v8::Int8Array    Type; };
+template <> struct TypedArrayFor<false, false, 1> { typedef v8::Uint8Array   Type; };
+template <> struct TypedArrayFor<false, true,  2> { typedef v8::Int16Array   Type; };
+template <> struct TypedArrayFor<false, false, 2> { typedef v8::Uint16Array  Type; };
+template <> struct TypedArrayFor<false, true,  4> { typedef v8::Int32Array   Type; };
+template <> struct TypedArrayFor<false, false, 4> { typedef v8::Uint32Array  Type; };
+template <> struct TypedArrayFor<true,  true,  4> { typedef v8::Float32Array Type; };
+template <> struct TypedArrayFor<true,  true,  8> { typedef v8::Float64Array Type; };
+
+#endif // NODE_MODULE_VERSION
+
+template <typename PolicyList, typename ReturnType>
+struct BatchResultType {
+	typedef typename std::conditional<
+		std::is_arithmetic<ReturnType>::value &&
+		!std::is_same<typename std::remove_cv<ReturnType>::type, bool>::value &&
+		!HasPolicy<Async, PolicyList>::value,
+		typename TypedArrayFor<
+			std::is_floating_point<ReturnType>::value,
+			std::is_signed<ReturnType>::value,
+			sizeof(ReturnType)
+		>::Type,
+		void
+	>::type Type;
+};
+
+} // namespace
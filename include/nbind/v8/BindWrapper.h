@@ -4,56 +4,21 @@
 #pragma once
 
 #include <memory>
-
-#if !defined(NBIND_DUPLICATE_POINTERS)
-
-#include <unordered_map>
-
-namespace nbind {
-
-template <typename A, typename B>
-class HashablePair : public std::pair<A, B> {
-
-public:
-
-	HashablePair(A a, B b) : std::pair<A, B>(a, b) {}
-
-};
-
-}
-
-namespace std {
-
-// Add hash functions for HashablePair and TypeFlags so they can be used
-// as keys in std::unordered_map.
-
-template<typename A, typename B> struct hash<nbind::HashablePair<A, B>> {
-	inline size_t operator()(const nbind::HashablePair<A, B> &obj) const {
-		size_t result = hash<A>()(obj.first) + 0x9e3779b9;
-
-		result = (result << 6) + (result >> 2);
-		result += hash<B>()(obj.second) + 0x9e3779b9;
-
-		return(result);
-	}
-};
-
-template<>
-struct hash<nbind::TypeFlags> {
-	inline size_t operator()(nbind::TypeFlags flags) const {
-		return(hash<uint32_t>()(static_cast<uint32_t>(flags)));
-	}
-};
-
-}
-
-#endif // NBIND_DUPLICATE_POINTERS
+#include <vector>
 
 #include <v8.h>
 #include <node.h>
 #include <node_buffer.h>
 #include <nan.h>
 
+#include "Trace.h"
+#include "LiveStats.h"
+#include "DestroyQueue.h"
+
+#if !defined(NBIND_DUPLICATE_POINTERS)
+#	include "InstanceTable.h"
+#endif
+
 namespace nbind {
 
 class BindClassBase;
@@ -81,101 +46,177 @@ public:
 
 #if !defined(NBIND_DUPLICATE_POINTERS)
 
-	static Nan::Persistent<v8::Object> *findInstance(const void *ptr, TypeFlags flags) {
-		// This will insert a null pointer (to a non-existent wrapper)
-		// in the map if the object pointer is not found yet.
+	// Find an existing wrapper for a pointer, or return nullptr.
+
+	static BindWrapperBase *findInstance(const void *ptr, TypeFlags flags) {
+		return(getInstanceTbl().find(ptr, flags));
+	}
+
+	// This is effectively a map from C++ instance pointers
+	// to JavaScript objects wrapping them. The wrappers are only
+	// referenced weakly by ObjectWrap, so entries get removed when
+	// the garbage collector frees them and calls their destructor.
+
+	static InstanceTable &getInstanceTbl() {
+		static thread_local InstanceTable instanceTbl;
 
-		return(&getInstanceTbl()[HashablePair<const void *, TypeFlags>(ptr, flags)]);
+		return(instanceTbl);
 	}
 
 #endif // NBIND_DUPLICATE_POINTERS
 
+	// Make any further access through the wrapper throw,
+	// when the object was destroyed by C++.
+
+	virtual void detach() {
+#		if !defined(NBIND_DUPLICATE_POINTERS)
+			removeInstance();
+#		endif // NBIND_DUPLICATE_POINTERS
+
+		removeLive();
+		releaseSize();
+		boundUnsafe = nullptr;
+	}
+
 	BindClassBase &getClass() { return(bindClass); }
 
+	// Bytes of C++ memory reported to the garbage collector.
+
+	size_t getExternalSize() const { return(externalSize); }
+
+	// Calls bindClass.getName();
+	// We don't want to depend on BindClass.h here.
+
+	const char *getClassName();
+
+	// Free the object, like calling free() from JavaScript.
+
+	virtual void destroy() = 0;
+
+	// Shared pointer owning the object, or empty for raw pointers.
+
+	virtual std::shared_ptr<void> getSharedBound() = 0;
+
+	// Keep the object when leaving binding.scope().
+
+	void persist() { isPersistent = true; }
+
+	bool getPersistent() const { return(isPersistent); }
+
+	// JavaScript objects of wrappers owning their C++ object, created inside
+	// each open binding.scope() call in the current thread, innermost last.
+
+	static std::vector<std::unique_ptr<Nan::Persistent<v8::Array>>> &getScopeStack() {
+		static thread_local std::vector<std::unique_ptr<Nan::Persistent<v8::Array>>> scopeStack;
+
+		return(scopeStack);
+	}
+
 	template <class Bound>
 	Bound *upcast();
 
 protected:
 
 	void wrapThis(const Nan::FunctionCallbackInfo<v8::Value> &args) {
+		wrapObject(args.This());
+	}
+
+	void wrapObject(v8::Local<v8::Object> obj) {
+		addLive();
+		addToScope(obj);
 
 #		if !defined(NBIND_DUPLICATE_POINTERS)
 
-			addInstance(args.This());
+			addInstance();
 
 #		endif // NBIND_DUPLICATE_POINTERS
 
-		this->Wrap(args.This());
+		this->Wrap(obj);
 	}
 
 #if !defined(NBIND_DUPLICATE_POINTERS)
 
-	// If the GC wants to free the wrapper object, get rid of our reference to it.
-
-	static void weakCallback(const Nan::WeakCallbackInfo<Nan::Persistent<v8::Object>> &data) {
-		// This causes a crash. Maybe it's a reference counter that already got decremented?
-		// data.GetParameter()->Reset();
-	}
-
 	// Add a mapping from a pointer to a wrapper object,
 	// to re-use the same wrapper for duplicates of the same pointer.
 
-	void addInstance(v8::Local<v8::Object> obj) {
-		Nan::Persistent<v8::Object> *ref = &getInstanceTbl()[
-			HashablePair<const void *, TypeFlags>(
-				boundUnsafe,
-				flags
-			)
-		];
+	void addInstance() {
+		getInstanceTbl().insert(boundUnsafe, flags, this);
+	}
 
-		ref->Reset(obj);
+	void removeInstance() {
+		getInstanceTbl().remove(boundUnsafe, flags, this);
+	}
 
-		// Mark the reference to the wrapper weak, so it can be
-		// garbage collected when no copies remain.
-		// If the same pointer needs wrapping later, we can just
-		// create a new wrapper again.
+#endif // NBIND_DUPLICATE_POINTERS
 
-		ref->SetWeak(ref, weakCallback, Nan::WeakCallbackType::kParameter);
-		ref->MarkIndependent();
-	}
+	// Tell V8 how much C++ memory the wrapper keeps alive,
+	// so the garbage collector runs often enough.
 
-	void removeInstance() {
-		// This causes a crash. Maybe it's a reference counter that already got decremented?
-		// auto iter = getInstanceTbl().find(bound.get());
-		// (*iter).second.Reset();
-
-		getInstanceTbl().erase(
-			HashablePair<const void *, TypeFlags>(
-				boundUnsafe,
-				flags
-			)
-		);
+	void reportSize(size_t size) {
+		externalSize = size;
+		Nan::AdjustExternalMemory(static_cast<int>(size));
 	}
 
-	// This is effectively a map from C++ instance pointers
-	// to weak references to JavaScript objects wrapping them.
+	// Raw pointers are owned by C++, so scopes never free them.
 
-	static std::unordered_map<
-		HashablePair<const void *, TypeFlags>,
-		Nan::Persistent<v8::Object>
-	> &getInstanceTbl() {
-		static std::unordered_map<
-			HashablePair<const void *, TypeFlags>,
-			Nan::Persistent<v8::Object>
-		> instanceTbl;
+	void addToScope(v8::Local<v8::Object> obj) {
+		auto &scopeStack = getScopeStack();
 
-		return(instanceTbl);
+		if(scopeStack.empty() || (flags & TypeFlags::refMask) != TypeFlags::isSharedPtr) return;
+
+		v8::Local<v8::Array> list = Nan::New(*scopeStack.back());
+
+		Nan::Set(list, list->Length(), obj);
 	}
 
-#endif // NBIND_DUPLICATE_POINTERS
+	// Update counts of live wrappers of the class. Defined in BindClass.h.
+
+	void addLive();
+	void removeLive();
+
+	void releaseSize() {
+		if(externalSize == 0) return;
+
+		Nan::AdjustExternalMemory(-static_cast<int>(externalSize));
+		externalSize = 0;
+	}
 
 	void *boundUnsafe;
 	TypeFlags flags;
+	size_t externalSize = 0;
+	/** Number of sampled construction site, or zero if not sampled. */
+	uint32_t siteNum = 0;
+	bool isPersistent = false;
 
 	BindClassBase &bindClass;
 
 };
 
+// Classes up to this size in bytes are allocated together with their wrapper
+// when created from JavaScript or returned by value. Off by default, because
+// the wrapper then keeps the object alive until garbage collection if C++
+// still held shared pointers to it when free() was called.
+// Specialize InlineStorage to choose differently for a single class.
+
+#if !defined(NBIND_INLINE_SIZE)
+#	define NBIND_INLINE_SIZE 0
+#endif
+
+template <class Bound>
+struct InlineStorage : public std::integral_constant<bool, sizeof(Bound) <= NBIND_INLINE_SIZE> {};
+
+// Bytes of C++ memory kept alive by a shared object wrapped for JavaScript,
+// reported to the garbage collector and shown in heap snapshots.
+// Specialize ExternalSize to include memory the class allocates itself.
+
+template <class Bound>
+struct ExternalSize {
+	static size_t get(const Bound &bound) { return(sizeof(Bound)); }
+};
+
+template <class Bound>
+class InlineBindWrapper;
+
 // BindWrapper encapsulates a C++ object created in Node.js.
 
 template <class Bound>
@@ -186,13 +227,31 @@ public:
 	BindWrapper(Bound *bound, TypeFlags flags) :
 		BindWrapperBase(bound, flags, getBindClass()) {}
 
+	// Raw pointers are owned by C++, so collecting their wrappers
+	// wouldn't free any memory and their size isn't reported.
+
 	BindWrapper(std::shared_ptr<Bound> bound, TypeFlags flags) :
-		BindWrapperBase(bound.get(), flags, getBindClass()), boundShared(bound) {}
+		BindWrapperBase(bound.get(), flags, getBindClass()), boundShared(bound) {
+		if(bound) reportSize(ExternalSize<Bound>::get(*bound));
+	}
 
 	// This destructor is called automatically by the JavaScript garbage collector.
 
 	~BindWrapper() {
+		if(!boundUnsafe) return;
+
+		TraceSpan trace(getClassName(), "destroy");
+
+		// Keep the last reference to release it later,
+		// if the class has a DestroyPolicy.
+
+		std::shared_ptr<Bound> shared;
+
+		if(DestroyPolicy<Bound>::value != DestroyMode::immediate) shared = std::move(boundShared);
+
 		destroy();
+
+		releaseCollected<Bound>(std::move(shared));
 	}
 
 	// Calls BindClass<Bound>::getInstance();
@@ -206,10 +265,78 @@ public:
 		const Nan::FunctionCallbackInfo<v8::Value> &nanArgs,
 		Args&&... args
 	) {
-		(new BindWrapper(
+		// Arenas find wrappers to detach in the instance table,
+		// so without one objects are allocated normally.
+
+#		if !defined(NBIND_DUPLICATE_POINTERS)
+			Arena *arena = ArenaAllocated<Bound>::value ? Arena::getCurrent() : nullptr;
+#		else
+			Arena *arena = nullptr;
+#		endif // NBIND_DUPLICATE_POINTERS
+
+		if(arena != nullptr) {
+			createInArena(*arena, args...)->wrapThis(nanArgs);
+			return;
+		}
+
+		createWrapper(
+			typename InlineStorage<Bound>::type(),
+			args...
+		)->wrapThis(nanArgs);
+	}
+
+	// The arena owns the object, so the shared pointer must not delete it.
+
+	template<typename... Args>
+	static BindWrapper *createInArena(Arena &arena, Args&&... args) {
+		Bound *ptr = ::new(arena.allocate(sizeof(Bound), alignof(Bound))) Bound(args...);
+
+		arena.addFinalizer(ptr, &BindWrapper::finalizeInArena);
+
+		BindWrapper *wrapper = new BindWrapper(
+			std::shared_ptr<Bound>(ptr, [](Bound *) {}),
+			TypeFlags::isSharedPtr
+		);
+
+		// Releasing the arena frees the memory, not the garbage collector.
+		wrapper->releaseSize();
+
+		return(wrapper);
+	}
+
+	// Called when the arena is released. Detach the wrapper still pointing
+	// to the object, if it wasn't garbage collected yet.
+
+	static void finalizeInArena(void *ptr) {
+#		if !defined(NBIND_DUPLICATE_POINTERS)
+			BindWrapperBase *wrapper = findInstance(ptr, TypeFlags::isSharedPtr);
+
+			if(wrapper != nullptr) wrapper->detach();
+#		endif // NBIND_DUPLICATE_POINTERS
+
+		static_cast<Bound *>(ptr)->~Bound();
+	}
+
+	std::shared_ptr<void> getSharedBound() override { return(boundShared); }
+
+	// Also drop the shared pointer, so getShared can't return it.
+
+	void detach() override {
+		BindWrapperBase::detach();
+		boundShared.reset();
+	}
+
+	template<typename... Args>
+	static BindWrapper *createWrapper(std::false_type isInline, Args&&... args) {
+		return(new BindWrapper(
 			std::make_shared<Bound>(args...),
 			TypeFlags::isSharedPtr
-		))->wrapThis(nanArgs);
+		));
+	}
+
+	template<typename... Args>
+	static BindWrapper *createWrapper(std::true_type isInline, Args&&... args) {
+		return(InlineBindWrapper<Bound>::create(TypeFlags::isSharedPtr, args...));
 	}
 
 	static void wrapPtr(const Nan::FunctionCallbackInfo<v8::Value> &nanArgs) {
@@ -230,7 +357,19 @@ public:
 		}
 	}
 
-	void destroy() {
+	// Wrap an object pointer instantiated in C++, attaching it to obj
+	// which was created from the instance template of the class
+	// without calling the JavaScript constructor.
+
+	static void wrapNew(v8::Local<v8::Object> obj, Bound *ptr, TypeFlags flags) {
+		(new BindWrapper(ptr, flags))->wrapObject(obj);
+	}
+
+	static void wrapNew(v8::Local<v8::Object> obj, std::shared_ptr<Bound> &&ptr, TypeFlags flags) {
+		(new BindWrapper(std::move(ptr), flags))->wrapObject(obj);
+	}
+
+	void destroy() override {
 
 		// Avoid freeing the object twice.
 		if(!boundUnsafe) return;
@@ -238,16 +377,18 @@ public:
 #		if !defined(NBIND_DUPLICATE_POINTERS)
 
 			// JavaScript side no longer holds any references to the object,
-			// so remove our weak pointer to the wrapper.
+			// so remove the wrapper from the instance table.
 
 			removeInstance();
 
 #		endif // NBIND_DUPLICATE_POINTERS
 
 		// Delete the bound object if the C++ side isn't holding onto it.
-		// The weak pointer must be removed first,
+		// The table entry must be removed first,
 		// because resetting changes the hash key.
 
+		removeLive();
+		releaseSize();
 		boundUnsafe = nullptr;
 		boundShared.reset();
 
@@ -288,4 +429,112 @@ private:
 
 };
 
+template <class Bound>
+struct InlineBlock;
+
+// Wrapper sharing a single allocation with the C++ object it wraps and
+// a shared_ptr control block. Shared pointers to the object alias the block,
+// so it stays alive while C++ holds any, even after the wrapper is collected.
+// Calling free() from JavaScript destroys the object in place unless C++
+// still holds shared pointers to it, and the memory is released together
+// with the wrapper.
+
+template <class Bound>
+class InlineBindWrapper : public BindWrapper<Bound> {
+
+public:
+
+	template<typename... Args>
+	static InlineBindWrapper *create(TypeFlags flags, Args&&... args) {
+		auto block = std::make_shared<InlineBlock<Bound>>(std::forward<Args>(args)...);
+		InlineBlock<Bound> *blockPtr = block.get();
+
+		auto *wrapper = ::new(&blockPtr->wrapper) InlineBindWrapper(
+			std::shared_ptr<Bound>(block, blockPtr->getBound()),
+			flags
+		);
+
+		// The block owns itself until the wrapper gets deleted.
+		blockPtr->self = std::move(block);
+
+		return(wrapper);
+	}
+
+	// Create a wrapper around a new C++ object
+	// and attach it to an object from the instance template of the class.
+
+	template<typename... Args>
+	static void wrapNew(v8::Local<v8::Object> obj, TypeFlags flags, Args&&... args) {
+		create(flags, std::forward<Args>(args)...)->wrapObject(obj);
+	}
+
+	// Run the destructor now, like a separately allocated object whose
+	// last shared pointer is released.
+
+	void destroy() override {
+		BindWrapper<Bound>::destroy();
+
+		InlineBlock<Bound> *block = reinterpret_cast<InlineBlock<Bound> *>(this);
+
+		if(block->self.use_count() == 1) block->destroyBound();
+	}
+
+	// The wrapper was not allocated by itself. After its destructor has run,
+	// drop the reference from the block to itself, freeing it unless C++
+	// still holds shared pointers to the object. The alias released in
+	// the destructor wasn't the last reference, so apply the DestroyPolicy here.
+
+	static void operator delete(void *ptr) {
+		InlineBlock<Bound> *block = reinterpret_cast<InlineBlock<Bound> *>(ptr);
+
+		std::shared_ptr<InlineBlock<Bound>> self(std::move(block->self));
+
+		releaseCollected<Bound>(std::move(self));
+	}
+
+private:
+
+	InlineBindWrapper(std::shared_ptr<Bound> &&bound, TypeFlags flags) :
+		BindWrapper<Bound>(std::move(bound), flags) {}
+
+};
+
+// Memory layout of an inline wrapper. The wrapper must be the first member,
+// so its address is also the address of the block.
+
+template <class Bound>
+struct InlineBlock {
+
+	template<typename... Args>
+	InlineBlock(Args&&... args) {
+		::new(&bound) Bound(std::forward<Args>(args)...);
+		isAlive = true;
+	}
+
+	~InlineBlock() { destroyBound(); }
+
+	Bound *getBound() { return(reinterpret_cast<Bound *>(&bound)); }
+
+	// The object may get destroyed before the block, by calling free().
+
+	void destroyBound() {
+		if(!isAlive) return;
+
+		isAlive = false;
+		getBound()->~Bound();
+	}
+
+	typename std::aligned_storage<
+		sizeof(InlineBindWrapper<Bound>),
+		alignof(InlineBindWrapper<Bound>)
+	>::type wrapper;
+
+	typename std::aligned_storage<sizeof(Bound), alignof(Bound)>::type bound;
+
+	bool isAlive = false;
+
+	std::shared_ptr<InlineBlock> self;
+
+};
+
 } // namespace
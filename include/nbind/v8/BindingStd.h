@@ -20,6 +20,10 @@ struct BindingType<std::array<ArgType, size>> {
 	typedef std::array<ArgType, size> Type;
 
 	static inline bool checkType(WireType arg) {
+		if(TypedArrayConverter<ArgType>::checkType(arg)) {
+			return(TypedArrayConverter<ArgType>::getLength(arg) >= size);
+		}
+
 		if(!arg->IsArray()) return(false);
 
 		v8::Local<v8::Array> arr = arg.template As<v8::Array>();
@@ -28,12 +32,18 @@ struct BindingType<std::array<ArgType, size>> {
 	}
 
 	static inline Type fromWireType(WireType arg) {
+		Type val;
+
+		if(TypedArrayConverter<ArgType>::checkType(arg)) {
+			// Copy typed array contents in bulk.
+			TypedArrayConverter<ArgType>::copyFromWire(arg, val, size);
+			return(val);
+		}
+
 		// TODO: Don't convert sparse arrays.
 
 		v8::Local<v8::Array> arr = arg.template As<v8::Array>();
 
-		Type val;
-
 		// Length of arr is checked in checkType().
 		for(uint32_t num = 0; num < size; ++num) {
 			v8::Local<v8::Value> item;
@@ -71,10 +81,21 @@ struct BindingType<std::vector<ArgType>> {
 	typedef std::vector<ArgType> Type;
 
 	static inline bool checkType(WireType arg) {
-		return(arg->IsArray());
+		return(arg->IsArray() || TypedArrayConverter<ArgType>::checkType(arg));
 	}
 
 	static inline Type fromWireType(WireType arg) {
+		Type val;
+
+		if(TypedArrayConverter<ArgType>::checkType(arg)) {
+			// Copy typed array contents in bulk.
+			size_t count = TypedArrayConverter<ArgType>::getLength(arg);
+
+			TypedArrayConverter<ArgType>::copyFromWire(arg, val, count);
+
+			return(val);
+		}
+
 		// TODO: Don't convert sparse arrays.
 
 		v8::Local<v8::Array> arr = arg.template As<v8::Array>();
@@ -82,7 +103,6 @@ struct BindingType<std::vector<ArgType>> {
 
 		// We know the length, so it's faster to preallocate the vector.
 
-		Type val;
 		val.reserve(count);
 
 		for(uint32_t num = 0; num < count; ++num) {
@@ -114,6 +134,30 @@ struct BindingType<std::vector<ArgType>> {
 
 };
 
+// Arrays and vectors returned as typed arrays (TypedArray policy).
+
+template <typename ArgType, size_t size>
+struct BindingType<TypedArrayType<std::array<ArgType, size>>> : public BindingType<std::array<ArgType, size>> {
+
+	typedef std::array<ArgType, size> Type;
+
+	static inline WireType toWireType(Type &&arg) {
+		return(TypedArrayConverter<ArgType>::toWireType(std::move(arg)));
+	}
+
+};
+
+template <typename ArgType>
+struct BindingType<TypedArrayType<std::vector<ArgType>>> : public BindingType<std::vector<ArgType>> {
+
+	typedef std::vector<ArgType> Type;
+
+	static inline WireType toWireType(Type &&arg) {
+		return(TypedArrayConverter<ArgType>::toWireType(std::move(arg)));
+	}
+
+};
+
 // String.
 
 template <> struct BindingType<std::string> {
@@ -125,8 +169,8 @@ template <> struct BindingType<std::string> {
 	}
 
 	static inline Type fromWireType(WireType arg) {
-		Nan::Utf8String val(Nan::To<v8::String>(arg).ToLocalChecked());
-		return(std::string(*val, val.length()));
+		StringBuffer val(arg);
+		return(std::string(val.data(), val.length()));
 	}
 
 	static inline WireType toWireType(Type arg) {
@@ -162,9 +206,11 @@ template <> struct BindingType<StrictType<const std::string &>> : public Binding
 template<typename PolicyList, size_t Index>
 struct ArgFromWire<PolicyList, Index, const std::string &> {
 
-	// TODO: Get string length from JS to support zero bytes?
+	// Decoding to the stack first leaves a single copy to the heap,
+	// only needed for strings too long for small string optimization.
 	template <typename NanArgs>
-	ArgFromWire(const NanArgs &args) : val(*Nan::Utf8String(Nan::To<v8::String>(args[Index]).ToLocalChecked())) {}
+	ArgFromWire(const NanArgs &args) :
+		val(BindingType<std::string>::fromWireType(checkedArg<PolicyList, Index, const std::string &>(args))) {}
 
 	template <typename NanArgs>
 	inline const std::string &get(const NanArgs &args) {
@@ -177,4 +223,47 @@ struct ArgFromWire<PolicyList, Index, const std::string &> {
 
 };
 
+#if defined(NBIND_STRING_VIEW)
+
+// String view, pointing to a temporary buffer valid until the function returns.
+
+template <> struct BindingType<std::string_view> {
+
+	typedef std::string_view Type;
+
+	static inline bool checkType(WireType arg) {
+		return(true);
+	}
+
+	static inline WireType toWireType(Type arg) {
+		return(Nan::New<v8::String>(arg.data(), arg.length()).ToLocalChecked());
+	}
+
+};
+
+template <> struct BindingType<StrictType<std::string_view>> : public BindingType<std::string_view> {
+	static inline bool checkType(WireType arg) {
+		return(arg->IsString());
+	}
+};
+
+template<typename PolicyList, size_t Index>
+struct ArgFromWire<PolicyList, Index, std::string_view> {
+
+	template <typename NanArgs>
+	ArgFromWire(const NanArgs &args) : val(checkedArg<PolicyList, Index, std::string_view>(args)) {}
+
+	template <typename NanArgs>
+	inline std::string_view get(const NanArgs &args) {
+		return(std::string_view(val.data(), val.length()));
+	}
+
+	// RAII style storage for the string data.
+
+	StringBuffer val;
+
+};
+
+#endif // NBIND_STRING_VIEW
+
 } // namespace
@@ -12,6 +12,15 @@ namespace nbind {
 
 typedef v8::Local<v8::Value> WireType;
 
+// Wrap a C++ object returned by value, allocated inline in its wrapper or
+// with a separate wrapper and shared_ptr. Defined in ValueObj.h.
+
+template <typename ArgType>
+WireType makeValueWrapper(ArgType &&arg, std::false_type isInline);
+
+template <typename ArgType>
+WireType makeValueWrapper(ArgType &&arg, std::true_type isInline);
+
 // Generic C++ object.
 
 template <typename ArgType> struct BindingType {
@@ -27,9 +36,12 @@ template <typename ArgType> struct BindingType {
 	}
 
 	static inline WireType toWireType(ArgType &&arg) {
-		return(BindingType<std::shared_ptr<ArgType>>::toWireType(
-			// Move construct from stack to heap.
-			std::make_shared<ArgType>(std::move(arg))
+		return(makeValueWrapper<ArgType>(
+			std::move(arg),
+			std::integral_constant<
+				bool,
+				InlineStorage<ArgType>::value && !std::is_const<ArgType>::value
+			>()
 		));
 	}
 
@@ -48,8 +48,45 @@ template<> struct BindingType<Buffer> {
 		return(result);
 	}
 
+	// Memory owned by the buffer moves into a Node.js Buffer without copying.
+	// Buffers from JavaScript are returned as the original object
+	// and other memory gets copied.
+
 	static inline WireType toWireType(Type arg) {
-		return(Nan::Null());
+		if(arg.owner) {
+			if(!arg.len) return(Nan::NewBuffer(0).ToLocalChecked());
+
+			return(Nan::NewBuffer(
+				reinterpret_cast<char *>(arg.ptr),
+				arg.len,
+				&release,
+				new std::shared_ptr<unsigned char>(std::move(arg.owner))
+			).ToLocalChecked());
+		}
+
+		if(!arg.handle.isEmpty()) return(arg.handle.getHandle());
+		if(!arg.ptr) return(Nan::Null());
+
+		return(Nan::CopyBuffer(reinterpret_cast<char *>(arg.ptr), arg.len).ToLocalChecked());
+	}
+
+	// Called when the Node.js Buffer gets garbage collected.
+
+	static void release(char *data, void *hint) {
+		delete static_cast<std::shared_ptr<unsigned char> *>(hint);
+	}
+
+};
+
+// Byte containers returned as Buffer objects without copying (Bytes policy).
+
+template <typename ArgType>
+struct BindingType<BytesType<ArgType>> : public BindingType<ArgType> {
+
+	typedef ArgType Type;
+
+	static inline WireType toWireType(Type &&arg) {
+		return(BindingType<Buffer>::toWireType(Buffer::adopt(std::move(arg))));
 	}
 
 };
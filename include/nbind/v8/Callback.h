@@ -45,6 +45,7 @@ public:
 
 	template <typename ReturnType, typename... Args>
 	typename TypeTransformer<ReturnType>::Type call(Args&&... args) const {
+		TraceSpan trace(nullptr, "callback");
 		v8::Local<v8::Value> argv[] = {
 			(convertToWire(std::move(args)))...,
 			// Avoid error C2466: cannot allocate an array of constant size 0.
@@ -63,6 +64,7 @@ public:
 		v8::Local<v8::Object> target,
 		Args&&... args
 	) const {
+		TraceSpan trace(nullptr, "callback");
 		v8::Local<v8::Value> argv[] = {
 			(convertToWire(std::move(args)))...,
 			// Avoid error C2466: cannot allocate an array of constant size 0.
@@ -124,7 +126,8 @@ template<typename PolicyList, size_t Index>
 struct ArgFromWire<PolicyList, Index, const cbFunction &> {
 
 	template <typename NanArgs>
-	ArgFromWire(const NanArgs &args) : val(args[Index].template As<v8::Function>()) {}
+	ArgFromWire(const NanArgs &args) :
+		val(checkedArg<PolicyList, Index, const cbFunction &>(args).template As<v8::Function>()) {}
 
 	template <typename NanArgs>
 	inline const cbFunction &get(const NanArgs &args) {
@@ -139,7 +142,8 @@ template<typename PolicyList, size_t Index>
 struct ArgFromWire<PolicyList, Index, cbFunction &> {
 
 	template <typename NanArgs>
-	ArgFromWire(const NanArgs &args) : val(args[Index].template As<v8::Function>()) {}
+	ArgFromWire(const NanArgs &args) :
+		val(checkedArg<PolicyList, Index, cbFunction &>(args).template As<v8::Function>()) {}
 
 	template <typename NanArgs>
 	inline cbFunction &get(const NanArgs &args) {
@@ -0,0 +1,187 @@
+// This file is part of nbind, copyright (C) 2014-2016 BusFaster Ltd.
+// Released under the MIT license, see LICENSE.
+
+// This file handles calling JavaScript callbacks from other threads.
+
+#pragma once
+
+#include <atomic>
+#include <uv.h>
+
+namespace nbind {
+
+// cbQueue calls a JavaScript function with payloads posted from any thread.
+// Posting pushes to a lock-free list and wakes up the main thread only if
+// the list was empty, so a burst of calls costs a single uv_async wakeup.
+// The main thread then makes the calls in posting order, or if coalescing,
+// a single call with an array of all payloads.
+// Construct and destroy it on the thread running JavaScript, after any posting
+// threads have stopped. Until destroyed, it keeps the event loop alive.
+
+template <typename Payload>
+class cbQueue {
+
+public:
+
+	explicit cbQueue(const cbFunction &func, bool coalesce = false) :
+		state(new State(func, coalesce)) {}
+
+	cbQueue(const cbQueue &) = delete;
+	cbQueue &operator=(const cbQueue &) = delete;
+
+	~cbQueue() { state->close(); }
+
+	// Safe to call from any thread.
+
+	void post(Payload payload) { state->post(std::move(payload)); }
+
+private:
+
+	// State is freed after libuv has closed its handle,
+	// which may happen after the queue is destroyed.
+
+	class State {
+
+	public:
+
+		State(const cbFunction &func, bool coalesce) :
+			func(func), resource("nbind:cbQueue"), coalesce(coalesce) {
+			uv_async_init(Nan::GetCurrentEventLoop(), &async, &State::wake);
+			async.data = this;
+		}
+
+		void post(Payload &&payload) {
+			Node *node = new Node { std::move(payload), nullptr };
+			Node *next = head.load(std::memory_order_relaxed);
+
+			// The main thread may take the node as soon as it's pushed,
+			// so only touch the local copy of its next pointer afterwards.
+
+			do {
+				node->next = next;
+			} while(!head.compare_exchange_weak(
+				next,
+				node,
+				std::memory_order_release,
+				std::memory_order_relaxed
+			));
+
+			// Only the first call in a batch needs to wake up the main thread.
+
+			if(next == nullptr) uv_async_send(&async);
+		}
+
+		void close() {
+			uv_close(reinterpret_cast<uv_handle_t *>(&async), &State::closed);
+		}
+
+	private:
+
+		struct Node {
+			Payload payload;
+			Node *next;
+		};
+
+#		if NODE_MODULE_VERSION >= 14 // >= Node.js 0.12
+			static void wake(uv_async_t *handle) {
+#		else
+			static void wake(uv_async_t *handle, int status) {
+#		endif
+			static_cast<State *>(handle->data)->drain();
+		}
+
+		static void closed(uv_handle_t *handle) {
+			Nan::HandleScope scope;
+			State *state = static_cast<State *>(handle->data);
+
+			// Drop payloads posted after the last wakeup.
+			Node *node = state->take();
+
+			while(node) {
+				Node *next = node->next;
+				delete(node);
+				node = next;
+			}
+
+			delete(state);
+		}
+
+		// Take all posted payloads, in posting order.
+
+		Node *take() {
+			Node *node = head.exchange(nullptr, std::memory_order_acquire);
+			Node *list = nullptr;
+
+			while(node) {
+				Node *next = node->next;
+				node->next = list;
+				list = node;
+				node = next;
+			}
+
+			return(list);
+		}
+
+		void drain() {
+			Nan::HandleScope scope;
+			Node *list = take();
+
+			if(list == nullptr) return;
+
+			if(coalesce) {
+				uint32_t count = 0;
+
+				for(Node *node = list; node; node = node->next) ++count;
+
+				v8::Local<v8::Array> payloadArray = Nan::New<v8::Array>(count);
+				count = 0;
+
+				while(list) {
+					Node *next = list->next;
+					Nan::Set(payloadArray, count++, convertToWire(std::move(list->payload)));
+					delete(list);
+					list = next;
+				}
+
+				call(payloadArray);
+			} else {
+				while(list) {
+					Nan::HandleScope scope;
+					Node *next = list->next;
+					v8::Local<v8::Value> arg = convertToWire(std::move(list->payload));
+
+					delete(list);
+					list = next;
+
+					call(arg);
+				}
+			}
+		}
+
+		// Exceptions thrown by the callback are reported as uncaught.
+
+		void call(v8::Local<v8::Value> arg) {
+			TraceSpan trace(nullptr, "callback");
+
+			resource.runInAsyncScope(
+				Nan::GetCurrentContext()->Global(),
+				func.getJsFunction(),
+				1,
+				&arg
+			);
+		}
+
+		std::atomic<Node *> head { nullptr };
+
+		uv_async_t async;
+		cbFunction func;
+		Nan::AsyncResource resource;
+		bool coalesce;
+
+	};
+
+	State *state;
+
+};
+
+} // namespace
@@ -34,6 +34,9 @@ v8::Local<v8::Value> makeTypeError(
 	return(err);
 }
 
+template<typename PolicyList, typename ArgType>
+struct IsPrimitiveType;
+
 // CheckWire verifies if the type of a JavaScript handle corresponds to a C++ type.
 
 template<typename PolicyList, size_t Index, typename ArgType>
@@ -46,6 +49,28 @@ struct CheckWire {
 		return(Transformed::Binding::checkType(args[Index]));
 	}
 
+	// Check a whole column of arguments to a batch call. Typed arrays only
+	// hold numbers, so their first element stands for the whole column.
+	// On failure, the failing row is selected for reporting the error.
+
+	template <typename BatchType>
+	static inline bool checkColumn(BatchType &args, uint32_t length) {
+		if(IsPrimitiveType<PolicyList, ArgType>::value) return(true);
+
+		uint32_t count = (args.isTyped(Index) && length > 0) ? 1 : length;
+
+		for(uint32_t row = 0; row < count; ++row) {
+			Nan::HandleScope scope;
+
+			if(!Transformed::Binding::checkType(args.getCell(Index, row))) {
+				args.setRow(row);
+				return(false);
+			}
+		}
+
+		return(true);
+	}
+
 };
 
 template<typename ArgList> struct Checker;
@@ -53,22 +78,23 @@ template<typename ArgList> struct Checker;
 template<typename... Args>
 struct Checker<TypeList<Args...>> {
 
-	static bool booleanAnd(bool flag) {
-		return(flag);
-	}
-
-	template <typename... Rest>
-	static bool booleanAnd(bool flag, Rest... rest) {
-		return(flag & booleanAnd(rest...));
-	}
+	// Check all arguments before converting any of them.
+	// Stops at the first mismatch.
 
 	template <typename NanArgs>
 	static bool typesAreValid(NanArgs &args) {
 		(void)args; // Silence possible compiler warning about unused parameter.
 
-		return(booleanAnd(Args::checkType(args)..., true));
+		bool ok = true;
+		bool okList[] = { (ok = ok && Args::checkType(args))..., true };
+
+		(void)okList;
+
+		return(ok);
 	}
 
+	// After a mismatch, check every argument to report which ones were wrong.
+
 	template <typename NanArgs>
 	static v8::Local<v8::Value> getTypeError(NanArgs &args, const TYPEID *typeList) {
 		(void)args; // Silence possible compiler warning about unused parameter.
@@ -78,22 +104,117 @@ struct Checker<TypeList<Args...>> {
 		return(makeTypeError(args, sizeof...(Args), typeList, flagList));
 	}
 
+	// Check all columns of a batch call before making any calls,
+	// one column at a time. Stops at the first mismatch.
+
+	template <typename BatchType>
+	static bool checkColumns(BatchType &args, uint32_t length) {
+		(void)length; // Silence possible compiler warning about unused parameter.
+
+		bool ok = true;
+		bool okList[] = { (ok = ok && Args::checkColumn(args, length))..., true };
+
+		(void)okList;
+
+		return(ok);
+	}
+
+};
+
+// Detect signatures passing only numbers and booleans without a Strict policy.
+// Any JavaScript value converts to them, so their arguments need no type checks.
+
+template<bool...> struct AllTrue;
+
+template<> struct AllTrue<> {
+	static constexpr bool value = true;
 };
 
-template<typename ReturnType, typename ArgList> struct Caller;
+template<bool First, bool... Rest>
+struct AllTrue<First, Rest...> {
+	static constexpr bool value = First && AllTrue<Rest...>::value;
+};
 
-template<typename ReturnType, typename... Args>
-struct Caller<ReturnType, TypeList<Args...>> {
+template<typename PolicyList, typename ArgType>
+struct IsPrimitiveType {
+	static constexpr bool value = std::is_arithmetic<ArgType>::value && std::is_same<
+		typename TypeTransformer<ArgType, PolicyList>::Binding,
+		BindingType<ArgType>
+	>::value;
+};
+
+template<typename PolicyList>
+struct IsPrimitiveType<PolicyList, void> {
+	static constexpr bool value = true;
+};
+
+template<typename PolicyList, typename ReturnType, typename... Args>
+struct IsPrimitiveSignature {
+	static constexpr bool value = AllTrue<
+		IsPrimitiveType<PolicyList, ReturnType>::value,
+		IsPrimitiveType<PolicyList, Args>::value...
+	>::value;
+};
+
+// Invoke receives already converted arguments and calls the C++ function,
+// so profiling can tell argument conversion apart from the call itself.
+
+template<typename ReturnType>
+struct Invoke {
+
+	template <class Bound, typename MethodType, typename... CallArgs>
+	static inline ReturnType callMethod(Bound &target, MethodType method, CallArgs &&... args) {
+		ProfileBody body;
+
+		return((target.*method)(std::forward<CallArgs>(args)...));
+	}
+
+	template <typename Function, typename... CallArgs>
+	static inline ReturnType callFunction(Function func, CallArgs &&... args) {
+		ProfileBody body;
+
+		return((*func)(std::forward<CallArgs>(args)...));
+	}
+
+};
+
+// PolicyList applies to the return value. ArgFromWire in ArgList already
+// applies it to arguments.
+
+template<typename ReturnType, typename ArgList, typename PolicyList = PolicyListType<>> struct Caller;
+
+template<typename ReturnType, typename... Args, typename PolicyList>
+struct Caller<ReturnType, TypeList<Args...>, PolicyList> {
+
+	// Call without converting the return value, for batch calls storing
+	// numbers directly in a typed array.
+
+	template <class Bound, typename MethodType, typename NanArgs>
+	static ReturnType invokeMethod(Bound &target, MethodType method, NanArgs &args) noexcept(false) {
+		(void)args; // Silence possible compiler warning about unused parameter.
+
+		return(Invoke<ReturnType>::callMethod(target, method, Args(args).get(args)...));
+	}
+
+	template <typename Function, typename NanArgs>
+	static ReturnType invokeFunction(Function func, NanArgs &args) noexcept(false) {
+		(void)args; // Silence possible compiler warning about unused parameter.
+
+		return(Invoke<ReturnType>::callFunction(func, Args(args).get(args)...));
+	}
 
 	template <class Bound, typename MethodType, typename NanArgs>
 	static WireType callMethod(Bound &target, MethodType method, NanArgs &args) noexcept(false) {
 		(void)args; // Silence possible compiler warning about unused parameter.
 
 		// Note that Args().get may throw.
-		return(MethodResultConverter<ReturnType>::toWireType(
-			(target.*method)(Args(args).get(args)...),
-			target,
-			0.0
+		return(MethodResultOwner<ReturnType>::link(
+			MethodResultConverter<ReturnType, PolicyList>::toWireType(
+				Invoke<ReturnType>::callMethod(target, method, Args(args).get(args)...),
+				target,
+				0.0
+			),
+			args
 		));
 	}
 
@@ -102,8 +223,8 @@ struct Caller<ReturnType, TypeList<Args...>> {
 		(void)args; // Silence possible compiler warning about unused parameter.
 
 		// Note that Args().get may throw.
-		return(convertToWire<ReturnType>(
-			(*func)(Args(args).get(args)...)
+		return(TypeTransformer<ReturnType, PolicyList>::Binding::toWireType(
+			Invoke<ReturnType>::callFunction(func, Args(args).get(args)...)
 		));
 	}
 
@@ -112,15 +233,15 @@ struct Caller<ReturnType, TypeList<Args...>> {
 // Specialize Caller for void return type, because toWireType needs a non-void
 // argument.
 
-template<typename... Args>
-struct Caller<void, TypeList<Args...>> {
+template<typename... Args, typename PolicyList>
+struct Caller<void, TypeList<Args...>, PolicyList> {
 
 	template <class Bound, typename MethodType, typename NanArgs>
 	static WireType callMethod(Bound &target, MethodType method, NanArgs &args) noexcept(false) {
 		(void)args; // Silence possible compiler warning about unused parameter.
 
 		// Note that Args().get may throw.
-		(target.*method)(Args(args).get(args)...);
+		Invoke<void>::callMethod(target, method, Args(args).get(args)...);
 
 		return(Nan::Undefined());
 	}
@@ -130,7 +251,7 @@ struct Caller<void, TypeList<Args...>> {
 		(void)args; // Silence possible compiler warning about unused parameter.
 
 		// Note that Args().get may throw.
-		(*func)(Args(args).get(args)...);
+		Invoke<void>::callFunction(func, Args(args).get(args)...);
 
 		return(Nan::Undefined());
 	}
@@ -11,15 +11,27 @@ namespace nbind {
 template <class Bound>
 cbFunction *getValueConstructorJS();
 
+// Create a JavaScript object from fields listed in NBIND_CLASS.
+// Returns false if the class has no fields. Defined in ValueObj.h.
+
+template <class Bound>
+bool fieldsToWire(const Bound &arg, v8::Local<v8::Value> &output);
+
 // Send value object to JavaScript using toJS method of its C++ class.
 // It was received by value, so it can be moved.
 
 template <typename ArgType>
 inline WireType BindingType<ValueType<ArgType>>::toWireType(ArgType &&arg) {
+	typedef typename std::remove_const<ArgType>::type BaseType;
+
+	TraceSpan trace(BindWrapper<BaseType>::getBindClass().getName(), "toJS");
 	v8::Local<v8::Value> output = Nan::Undefined();
-	cbFunction *jsConstructor = getValueConstructorJS<
-		typename std::remove_const<ArgType>::type
-	>();
+
+	if(fieldsToWire<BaseType>(arg, output)) {
+		return(output);
+	}
+
+	cbFunction *jsConstructor = getValueConstructorJS<BaseType>();
 
 	if(jsConstructor != nullptr) {
 		cbOutput construct(*jsConstructor, &output);
@@ -37,7 +49,7 @@ inline WireType BindingType<ValueType<ArgType>>::toWireType(ArgType &&arg) {
 // This converter allows overriding the return type's toJS function
 // with the wrapped object's toJS function.
 
-template<typename ReturnType> struct MethodResultConverter {
+template<typename ReturnType, typename PolicyList = PolicyListType<>> struct MethodResultConverter {
 
 	// Call the toJS method of a returned C++ object, to convert it into a JavaScript object.
 	// This is used when a C++ function is called from JavaScript.
@@ -53,6 +65,7 @@ template<typename ReturnType> struct MethodResultConverter {
 		// Actual return type of this function: WireType (decltype adds a reference, which is removed).
 		*(WireType *)nullptr
 	)>::type {
+		TraceSpan trace(BindWrapper<ReturnType>::getBindClass().getName(), "toJS");
 		v8::Local<v8::Value> output = Nan::Undefined();
 		cbFunction *jsConstructor = getValueConstructorJS<ReturnType>();
 
@@ -69,10 +82,23 @@ template<typename ReturnType> struct MethodResultConverter {
 
 	// If Bound::toJS(ReturnType, cbOutput) is missing
 	// (bound may not even be a class), fall back to ReturnType::toJS(cbOutput).
+	// Policies of the method apply to the result.
 
 	template <typename Bound>
 	static inline WireType toWireType(ReturnType &&result, Bound &target, double dummy) {
-		return(convertToWire(std::forward<ReturnType>(result)));
+		return(TypeTransformer<ReturnType, PolicyList>::Binding::toWireType(std::forward<ReturnType>(result)));
+	}
+
+};
+
+// Returned values aliasing memory inside the bound object keep the object's
+// JavaScript wrapper alive. Other values are returned unchanged.
+
+template<typename ReturnType> struct MethodResultOwner {
+
+	template <typename NanArgs>
+	static inline WireType link(WireType result, NanArgs &args) {
+		return(result);
 	}
 
 };
@@ -0,0 +1,112 @@
+// This file is part of nbind, copyright (C) 2014-2016 BusFaster Ltd.
+// Released under the MIT license, see LICENSE.
+
+// This file caches objects needed for converting JavaScript objects with
+// a fromJS method (value objects and 64-bit integers) into C++ values,
+// so they don't need to be created again for every conversion.
+
+#pragma once
+
+namespace nbind {
+
+class ConverterCache {
+
+public:
+
+	// Eternal handle for the "fromJS" property name.
+
+	static v8::Local<v8::String> getFromJSKey() {
+		static thread_local Nan::Persistent<v8::String> key(Nan::New<v8::String>("fromJS").ToLocalChecked());
+
+		return(Nan::New(key));
+	}
+
+	// Get an object for passing data back to C++, created from tmpl
+	// on the first call. Its internal field points to the C++ storage.
+
+	v8::Local<v8::Object> getStorage(v8::Local<v8::ObjectTemplate> tmpl) {
+		if(storage.IsEmpty()) {
+			v8::Local<v8::Object> obj = Nan::NewInstance(tmpl).ToLocalChecked();
+
+			Nan::SetInternalFieldPointer(obj, 0, nullptr);
+			storage.Reset(obj);
+		}
+
+		return(Nan::New(storage));
+	}
+
+	// Call the fromJS method of target with a storage object able to
+	// receive the values at data. Return false if fromJS is missing.
+	// The method is always looked up, so own methods and methods replaced
+	// on the prototype are found. A callable handle for the last inherited
+	// method is cached, so it only gets created again for a different one.
+
+	bool callFromJS(
+		v8::Local<v8::Object> target,
+		v8::Local<v8::ObjectTemplate> tmpl,
+		void *data
+	) {
+		v8::Local<v8::Object> storageObj = getStorage(tmpl);
+		v8::Local<v8::String> key = getFromJSKey();
+		v8::Local<v8::Value> fromJS;
+
+		if(!Nan::Get(target, key).ToLocal(&fromJS) || !fromJS->IsFunction()) return(false);
+
+		// Conversions may be nested, so restore the previous target
+		// of the storage object when done.
+
+		StoragePointer ptr(storageObj, data);
+
+		v8::Local<v8::Function> func = fromJS.As<v8::Function>();
+
+		if(converter != nullptr && converter->getJsFunction()->StrictEquals(func)) {
+			converter->callMethod<void>(target, storageObj);
+		} else if(!Nan::HasOwnProperty(target, key).FromMaybe(true)) {
+			// The method was inherited from a prototype, so cache it.
+
+			if(converter != nullptr) delete(converter);
+			converter = new cbFunction(func);
+
+			converter->callMethod<void>(target, storageObj);
+		} else {
+			cbFunction(func).callMethod<void>(target, storageObj);
+		}
+
+		return(true);
+	}
+
+private:
+
+	// Point the internal field of a storage object to C++ memory
+	// while it's in scope.
+
+	class StoragePointer {
+
+	public:
+
+		StoragePointer(v8::Local<v8::Object> obj, void *data) :
+			obj(obj), prev(Nan::GetInternalFieldPointer(obj, 0))
+		{
+			Nan::SetInternalFieldPointer(obj, 0, data);
+		}
+
+		~StoragePointer() {
+			Nan::SetInternalFieldPointer(obj, 0, prev);
+		}
+
+	private:
+
+		v8::Local<v8::Object> obj;
+		void *prev;
+
+	};
+
+	Nan::Persistent<v8::Object> storage;
+
+	// Pointer for the same reason as BindClassBase::valueConstructorJS.
+
+	cbFunction *converter = nullptr;
+
+};
+
+} // namespace
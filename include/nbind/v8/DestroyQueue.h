@@ -0,0 +1,205 @@
+// This file is part of nbind, copyright (C) 2014-2016 BusFaster Ltd.
+// Released under the MIT license, see LICENSE.
+
+// This file handles destroying objects outside the garbage collector,
+// for classes with a DestroyPolicy other than DestroyImmediately.
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <uv.h>
+
+namespace nbind {
+
+// Releases references in a single background thread shared by all
+// threads running JavaScript.
+
+class ThreadDestroyQueue {
+
+public:
+
+	static void post(std::shared_ptr<void> &&ptr) {
+		State &state = getState();
+
+		{
+			std::lock_guard<std::mutex> lock(state.mutex);
+
+			state.pendingList.push_back(std::move(ptr));
+		}
+
+		state.wake.notify_one();
+	}
+
+private:
+
+	class State {
+
+	public:
+
+		State() : thread(&State::run, this) {
+			thread.detach();
+		}
+
+		std::mutex mutex;
+		std::condition_variable wake;
+		std::vector<std::shared_ptr<void>> pendingList;
+
+	private:
+
+		void run() {
+			std::vector<std::shared_ptr<void>> list;
+
+			while(true) {
+				{
+					std::unique_lock<std::mutex> lock(mutex);
+
+					wake.wait(lock, [this] { return(!pendingList.empty()); });
+					list.swap(pendingList);
+				}
+
+				// Run destructors without holding the lock.
+				list.clear();
+			}
+		}
+
+		// Must be initialized last, because the thread uses other members.
+		std::thread thread;
+
+	};
+
+	// Never freed, so the thread can run until the process exits.
+	// Objects still queued then are never destroyed, as if they were
+	// still waiting for the garbage collector.
+
+	static State &getState() {
+		static State *state = new State();
+
+		return(*state);
+	}
+
+};
+
+// Releases references on the thread running JavaScript, for objects
+// that aren't thread safe. A timer releases them oldest first, until
+// sliceTime has passed, and then lets the event loop run again.
+
+class IdleDestroyQueue {
+
+public:
+
+	/** Maximum nanoseconds spent destroying objects between events. */
+	static NBIND_CONSTEXPR uint64_t sliceTime = 1000000;
+
+	static void post(std::shared_ptr<void> &&ptr) {
+		State *&state = getState();
+
+		if(state == nullptr) state = new State();
+
+		state->pendingList.push_back(std::move(ptr));
+
+		if(!state->isScheduled) {
+			state->isScheduled = true;
+			uv_timer_start(&state->timer, &State::drain, 0, 0);
+		}
+	}
+
+private:
+
+	class State {
+
+	public:
+
+		State() {
+			uv_timer_init(Nan::GetCurrentEventLoop(), &timer);
+			timer.data = this;
+
+			// Pending objects shouldn't keep the process running.
+			uv_unref(reinterpret_cast<uv_handle_t *>(&timer));
+
+#			if NODE_MODULE_VERSION >= 64 // >= Node.js 10
+				node::AddEnvironmentCleanupHook(v8::Isolate::GetCurrent(), &State::cleanup, this);
+#			endif
+		}
+
+#		if NODE_MODULE_VERSION >= 14 // >= Node.js 0.12
+			static void drain(uv_timer_t *handle) {
+#		else
+			static void drain(uv_timer_t *handle, int status) {
+#		endif
+			Nan::HandleScope scope;
+			State *state = static_cast<State *>(handle->data);
+			uint64_t end = uv_hrtime() + sliceTime;
+
+			do {
+				state->pendingList.pop_front();
+			} while(!state->pendingList.empty() && uv_hrtime() < end);
+
+			if(state->pendingList.empty()) {
+				state->isScheduled = false;
+			} else {
+				uv_timer_start(&state->timer, &State::drain, 0, 0);
+			}
+		}
+
+		// The environment of a worker thread is shutting down.
+
+		static void cleanup(void *arg) {
+			State *state = static_cast<State *>(arg);
+
+			state->pendingList.clear();
+			getState() = nullptr;
+
+			uv_close(reinterpret_cast<uv_handle_t *>(&state->timer), &State::closed);
+		}
+
+		static void closed(uv_handle_t *handle) {
+			delete(static_cast<State *>(handle->data));
+		}
+
+		uv_timer_t timer;
+		std::deque<std::shared_ptr<void>> pendingList;
+		bool isScheduled = false;
+
+	};
+
+	// Each thread running JavaScript has its own event loop.
+
+	static State *&getState() {
+		static thread_local State *state = nullptr;
+
+		return(state);
+	}
+
+};
+
+// Release the last reference to an object freed by the garbage collector,
+// as chosen by the DestroyPolicy of its class. Type differs from Bound
+// for objects stored inline, owned by their InlineBlock.
+
+template <class Bound, class Type>
+inline void releaseCollected(std::shared_ptr<Type> &&ptr) {
+	// References held elsewhere can be dropped at once,
+	// because the destructor won't run.
+
+	if(ptr.use_count() != 1) return;
+
+	switch(DestroyPolicy<Bound>::value) {
+		case DestroyMode::inThread:
+			ThreadDestroyQueue::post(std::move(ptr));
+			break;
+
+		case DestroyMode::whenIdle:
+			IdleDestroyQueue::post(std::move(ptr));
+			break;
+
+		case DestroyMode::immediate:
+			break;
+	}
+}
+
+} // namespace
@@ -52,6 +52,8 @@ public:
 		return(Nan::New(handle));
 	}
 
+	bool isEmpty() const { return(handle.IsEmpty()); }
+
 private:
 
 	// Destructor info attached to an object for detecting when it gets
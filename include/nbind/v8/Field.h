@@ -0,0 +1,89 @@
+// This file is part of nbind, copyright (C) 2014-2016 BusFaster Ltd.
+// Released under the MIT license, see LICENSE.
+
+// This file handles fields of value objects listed in NBIND_CLASS.
+// They are read and written directly as JavaScript object properties,
+// instead of calling toJS and fromJS.
+
+#pragma once
+
+namespace nbind {
+
+class FieldBase {
+
+public:
+
+	explicit FieldBase(const char *name) : name(name), keyNum(getKeyCount()++) {}
+
+	virtual ~FieldBase() {}
+
+	const char *getName() const { return(name); }
+
+	// Property name, created once in each thread running JavaScript
+	// and then re-used.
+
+	v8::Local<v8::String> getKey() {
+		static thread_local std::vector<std::unique_ptr<Nan::Persistent<v8::String>>> keyList;
+
+		if(keyNum >= keyList.size()) keyList.resize(keyNum + 1);
+
+		std::unique_ptr<Nan::Persistent<v8::String>> &key = keyList[keyNum];
+
+		if(!key) key.reset(new Nan::Persistent<v8::String>(Nan::New<v8::String>(name).ToLocalChecked()));
+
+		return(Nan::New(*key));
+	}
+
+	// Convert the field in a C++ object to JavaScript.
+
+	virtual WireType read(const void *obj) const = 0;
+
+	// Set the field in a C++ object from JavaScript.
+	// Return false on type mismatch.
+
+	virtual bool write(void *obj, WireType arg) const = 0;
+
+private:
+
+	static std::atomic<unsigned int> &getKeyCount() {
+		static std::atomic<unsigned int> count(0);
+
+		return(count);
+	}
+
+	const char *name;
+
+	// Index of the property name in per-thread key lists.
+	const unsigned int keyNum;
+
+};
+
+template <class Bound, typename MemberType>
+class Field : public FieldBase {
+
+public:
+
+	Field(const char *name, MemberType Bound::*member) :
+		FieldBase(name), member(member) {}
+
+	WireType read(const void *obj) const override {
+		return(convertToWire<MemberType>(static_cast<const Bound *>(obj)->*member));
+	}
+
+	bool write(void *obj, WireType arg) const override {
+		typedef TypeTransformer<MemberType> Transformed;
+
+		if(!Transformed::Binding::checkType(arg)) return(false);
+
+		static_cast<Bound *>(obj)->*member = Transformed::Binding::fromWireType(arg);
+
+		return(true);
+	}
+
+private:
+
+	MemberType Bound::*member;
+
+};
+
+} // namespace
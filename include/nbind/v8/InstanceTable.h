@@ -0,0 +1,171 @@
+// This file is part of nbind, copyright (C) 2014-2016 BusFaster Ltd.
+// Released under the MIT license, see LICENSE.
+
+// This file maps pointers to C++ objects into their JavaScript wrappers,
+// so returning the same pointer again gives the same wrapper object.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace nbind {
+
+class BindWrapperBase;
+
+// Hash table with open addressing and linear probing. All entries are stored
+// in a single flat array, so a lookup usually touches only one cache line.
+// Removed entries are filled by shifting later entries backwards,
+// so no tombstones accumulate however many wrappers come and go.
+
+class InstanceTable {
+
+public:
+
+	static NBIND_CONSTEXPR size_t minCapacity = 64;
+
+	struct Stats {
+		double lookups;
+		double probes;
+		uint32_t longestProbe;
+	};
+
+	InstanceTable() { resize(minCapacity); }
+
+	BindWrapperBase *find(const void *ptr, TypeFlags flags) {
+		size_t pos = getHome(ptr, flags);
+		uint32_t probeCount = 1;
+
+		while(entryList[pos].wrapper != nullptr) {
+			if(entryList[pos].ptr == ptr && entryList[pos].flags == flags) break;
+
+			pos = (pos + 1) & mask;
+			++probeCount;
+		}
+
+		++stats.lookups;
+		stats.probes += probeCount;
+		if(probeCount > stats.longestProbe) stats.longestProbe = probeCount;
+
+		return(entryList[pos].wrapper);
+	}
+
+	// Add or replace the wrapper for a pointer.
+
+	void insert(const void *ptr, TypeFlags flags, BindWrapperBase *wrapper) {
+		// Keep the load factor at most 1/2 for short probe sequences.
+		if((count + 1) * 2 > entryList.size()) resize(entryList.size() * 2);
+
+		size_t pos = findSlot(ptr, flags);
+		Entry &entry = entryList[pos];
+
+		if(entry.wrapper == nullptr) ++count;
+
+		entry.ptr = ptr;
+		entry.flags = flags;
+		entry.wrapper = wrapper;
+	}
+
+	// Remove the entry for a pointer, unless it already refers
+	// to a different wrapper.
+
+	void remove(const void *ptr, TypeFlags flags, BindWrapperBase *wrapper) {
+		size_t hole = findSlot(ptr, flags);
+
+		if(entryList[hole].wrapper != wrapper || wrapper == nullptr) return;
+
+		for(
+			size_t pos = (hole + 1) & mask;
+			entryList[pos].wrapper != nullptr;
+			pos = (pos + 1) & mask
+		) {
+			size_t home = getHome(entryList[pos].ptr, entryList[pos].flags);
+
+			// Move the entry into the hole unless that would place it
+			// before its home slot.
+
+			if(((pos - home) & mask) >= ((pos - hole) & mask)) {
+				entryList[hole] = entryList[pos];
+				hole = pos;
+			}
+		}
+
+		entryList[hole].wrapper = nullptr;
+		--count;
+
+		// Release memory after large numbers of wrappers were collected.
+		if(entryList.size() > minCapacity && count * 8 < entryList.size()) {
+			resize(entryList.size() / 2);
+		}
+	}
+
+	template <typename Callback>
+	void forEach(Callback callback) const {
+		for(const Entry &entry : entryList) {
+			if(entry.wrapper != nullptr) callback(entry.wrapper);
+		}
+	}
+
+	size_t size() const { return(count); }
+
+	size_t capacity() const { return(entryList.size()); }
+
+	const Stats &getStats() const { return(stats); }
+
+private:
+
+	struct Entry {
+		const void *ptr;
+		TypeFlags flags;
+		BindWrapperBase *wrapper;
+	};
+
+	// Fibonacci hashing, taking the high bits of the product.
+
+	size_t getHome(const void *ptr, TypeFlags flags) const {
+		uint64_t key = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(ptr)) ^ static_cast<uint32_t>(flags);
+
+		return(static_cast<size_t>((key * UINT64_C(0x9e3779b97f4a7c15)) >> shift));
+	}
+
+	// Find the slot holding a pointer, or the empty slot ending its probe sequence.
+
+	size_t findSlot(const void *ptr, TypeFlags flags) const {
+		size_t pos = getHome(ptr, flags);
+
+		while(entryList[pos].wrapper != nullptr) {
+			if(entryList[pos].ptr == ptr && entryList[pos].flags == flags) break;
+
+			pos = (pos + 1) & mask;
+		}
+
+		return(pos);
+	}
+
+	// Capacity must be a power of two.
+
+	void resize(size_t newCapacity) {
+		std::vector<Entry> oldList(newCapacity, Entry { nullptr, TypeFlags::none, nullptr });
+
+		oldList.swap(entryList);
+		mask = newCapacity - 1;
+
+		shift = 64;
+		for(size_t num = newCapacity; num > 1; num >>= 1) --shift;
+
+		for(Entry &entry : oldList) {
+			if(entry.wrapper != nullptr) entryList[findSlot(entry.ptr, entry.flags)] = entry;
+		}
+	}
+
+	std::vector<Entry> entryList;
+
+	size_t count = 0;
+	size_t mask;
+	unsigned int shift;
+
+	Stats stats = { 0, 0, 0 };
+
+};
+
+} // namespace
@@ -7,32 +7,57 @@ namespace nbind {
 
 class Int64 {};
 
-template <typename ArgType>
-static ArgType int64FromWire(WireType arg, void(init)(const Nan::FunctionCallbackInfo<v8::Value> &args)) {
-	Nan::HandleScope();
+// Storage template and converter cache for each 64-bit type.
 
-	auto target = Nan::To<v8::Object>(arg).ToLocalChecked();
-	auto fromJS = target->Get(Nan::New<v8::String>("fromJS").ToLocalChecked());
+template <typename ArgType, void(*init)(const Nan::FunctionCallbackInfo<v8::Value> &args)>
+struct Int64Cache {
+	static v8::Local<v8::ObjectTemplate> getTemplate() {
+		static thread_local Nan::Persistent<v8::ObjectTemplate> storageTemplate;
 
-	if(!fromJS->IsFunction()) throw(std::runtime_error("Type mismatch"));
+		if(storageTemplate.IsEmpty()) {
+			auto tmpl = Nan::New<v8::ObjectTemplate>();
 
-	ArgType storage = 0;
+			tmpl->SetInternalFieldCount(1);
+			Nan::SetCallAsFunctionHandler(tmpl, init);
+
+			storageTemplate.Reset(tmpl);
+		}
+
+		return(Nan::New(storageTemplate));
+	}
 
-	// TODO: cache this for a speedup (replace init param).
-	auto storageTemplate = Nan::New<v8::ObjectTemplate>();
-	storageTemplate->SetInternalFieldCount(1);
-	Nan::SetCallAsFunctionHandler(storageTemplate, init);
+	static ConverterCache &getCache() {
+		static thread_local ConverterCache cache;
 
-	auto instance = Nan::NewInstance(storageTemplate).ToLocalChecked();
-	Nan::SetInternalFieldPointer(instance, 0, &storage);
+		return(cache);
+	}
+};
+
+template <typename ArgType, void(*init)(const Nan::FunctionCallbackInfo<v8::Value> &args)>
+static ArgType int64FromWire(WireType arg) {
+	typedef Int64Cache<ArgType, init> Cache;
+
+	auto target = Nan::To<v8::Object>(arg).ToLocalChecked();
+
+	ArgType storage = 0;
 
-	// TODO: cache this for a speedup.
-	cbFunction converter(v8::Local<v8::Function>::Cast(fromJS));
-	converter.callMethod<void>(target, instance);
+	if(!Cache::getCache().callFromJS(target, Cache::getTemplate(), &storage)) {
+		throw(std::runtime_error("Type mismatch"));
+	}
 
 	return(storage);
 }
 
+// Get storage for an integer passed from JavaScript,
+// or null if called outside a conversion.
+
+template <typename ArgType>
+static inline ArgType *getInt64Storage(const Nan::FunctionCallbackInfo<v8::Value> &args) {
+	args.GetReturnValue().Set(Nan::Undefined());
+
+	return(static_cast<ArgType *>(Nan::GetInternalFieldPointer(args.Holder(), 0)));
+}
+
 // Fast code path for 32-bit types.
 
 template <int size> struct Int64Converter {
@@ -48,23 +73,25 @@ template <int size> struct Int64Converter {
 
 	template <typename ArgType>
 	static void uint64Init(const Nan::FunctionCallbackInfo<v8::Value> &args) {
-		ArgType &storage = *static_cast<ArgType *>(Nan::GetInternalFieldPointer(args.Holder(), 0));
+		ArgType *storagePtr = getInt64Storage<ArgType>(args);
+		if(!storagePtr) return;
+
+		ArgType &storage = *storagePtr;
 
 		unsigned int argc = args.Length();
 		if(argc > 0) storage = Nan::To<unsigned int>(args[0]).FromJust();
-
-		args.GetReturnValue().Set(Nan::Undefined());
 	}
 
 	template <typename ArgType>
 	static void int64Init(const Nan::FunctionCallbackInfo<v8::Value> &args) {
-		ArgType &storage = *static_cast<ArgType *>(Nan::GetInternalFieldPointer(args.Holder(), 0));
+		ArgType *storagePtr = getInt64Storage<ArgType>(args);
+		if(!storagePtr) return;
+
+		ArgType &storage = *storagePtr;
 
 		unsigned int argc = args.Length();
 		if(argc > 0) storage = Nan::To<unsigned int>(args[0]).FromJust();
 		if(argc > 2 && Nan::To<bool>(args[2]).FromJust()) storage = -storage;
-
-		args.GetReturnValue().Set(Nan::Undefined());
 	}
 };
 
@@ -134,25 +161,27 @@ template<> struct Int64Converter<8> {
 
 	template <typename ArgType>
 	static void uint64Init(const Nan::FunctionCallbackInfo<v8::Value> &args) {
-		ArgType &storage = *static_cast<ArgType *>(Nan::GetInternalFieldPointer(args.Holder(), 0));
+		ArgType *storagePtr = getInt64Storage<ArgType>(args);
+		if(!storagePtr) return;
+
+		ArgType &storage = *storagePtr;
 
 		unsigned int argc = args.Length();
 		if(argc > 0) storage = Nan::To<unsigned int>(args[0]).FromJust();
 		if(argc > 1) storage += static_cast<uint64_t>(Nan::To<unsigned int>(args[1]).FromJust()) << 32;
-
-		args.GetReturnValue().Set(Nan::Undefined());
 	}
 
 	template <typename ArgType>
 	static void int64Init(const Nan::FunctionCallbackInfo<v8::Value> &args) {
-		ArgType &storage = *static_cast<ArgType *>(Nan::GetInternalFieldPointer(args.Holder(), 0));
+		ArgType *storagePtr = getInt64Storage<ArgType>(args);
+		if(!storagePtr) return;
+
+		ArgType &storage = *storagePtr;
 
 		unsigned int argc = args.Length();
 		if(argc > 0) storage = Nan::To<unsigned int>(args[0]).FromJust();
 		if(argc > 1) storage += static_cast<uint64_t>(Nan::To<unsigned int>(args[1]).FromJust()) << 32;
 		if(argc > 2 && Nan::To<bool>(args[2]).FromJust()) storage = -storage;
-
-		args.GetReturnValue().Set(Nan::Undefined());
 	}
 };
 
@@ -170,7 +199,7 @@ template <> struct BindingType<ArgType> {                   \
 	                                                        \
 	static inline Type fromWireType(WireType arg) {         \
 		if(arg->IsObject()) {                               \
-			return(int64FromWire<ArgType>(arg, Int64Converter<sizeof(Type)>::decode<ArgType>)); \
+			return(int64FromWire<ArgType, Int64Converter<sizeof(Type)>::decode<ArgType>>(arg)); \
 		} else {                                            \
 			return(static_cast<Type>(Nan::To<double>(arg).FromJust()));  \
 		}                                                   \
@@ -0,0 +1,136 @@
+// This file is part of nbind, copyright (C) 2014-2016 BusFaster Ltd.
+// Released under the MIT license, see LICENSE.
+
+// This file handles counting live wrappers of C++ objects
+// and sampling where they were constructed in JavaScript.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace nbind {
+
+// Counts of live wrappers of a single class in the current thread.
+
+struct LiveStats {
+	uint32_t live = 0;
+	uint32_t shared = 0;
+	uint32_t raw = 0;
+	uint32_t constant = 0;
+
+	/** Memory reported to the garbage collector. */
+	double bytes = 0;
+};
+
+// AllocationSampler records the JavaScript stack for one in every
+// few wrappers constructed, grouped by class and stack.
+
+class AllocationSampler {
+
+public:
+
+	static NBIND_CONSTEXPR int maxFrames = 16;
+
+	struct Site {
+		const char *className;
+		std::string stack;
+		uint32_t live;
+		uint32_t total;
+	};
+
+	/** Sample one in interval wrappers, or none if zero. */
+
+	static void setInterval(uint32_t interval) {
+		State &state = getState();
+
+		state.interval = interval;
+		state.countdown = interval;
+	}
+
+	/** Get a site number for a new wrapper, or zero if not sampled. */
+
+	static uint32_t sample(const char *className) {
+		State &state = getState();
+
+		if(state.interval == 0 || --state.countdown != 0) return(0);
+
+		state.countdown = state.interval;
+
+		std::string stack = getStack();
+		std::string key = std::string(className) + '\n' + stack;
+		uint32_t &siteNum = state.siteTbl[key];
+
+		if(siteNum == 0) {
+			state.siteList.push_back(Site { className, std::move(stack), 0, 0 });
+			siteNum = static_cast<uint32_t>(state.siteList.size());
+		}
+
+		Site &site = state.siteList[siteNum - 1];
+
+		++site.live;
+		++site.total;
+
+		return(siteNum);
+	}
+
+	/** The wrapper with a site number was destroyed. */
+
+	static void release(uint32_t siteNum) {
+		if(siteNum != 0) --getState().siteList[siteNum - 1].live;
+	}
+
+	static const std::vector<Site> &getSiteList() { return(getState().siteList); }
+
+private:
+
+	struct State {
+		uint32_t interval = 0;
+		uint32_t countdown = 0;
+
+		std::vector<Site> siteList;
+		/** Site numbers (starting from 1) by class name and stack. */
+		std::unordered_map<std::string, uint32_t> siteTbl;
+	};
+
+	// Each thread running JavaScript samples its own wrappers.
+
+	static State &getState() {
+		static thread_local State state;
+
+		return(state);
+	}
+
+	static std::string getStack() {
+		v8::Isolate *isolate = v8::Isolate::GetCurrent();
+		v8::Local<v8::StackTrace> trace = v8::StackTrace::CurrentStackTrace(isolate, maxFrames);
+		int frameCount = trace->GetFrameCount();
+		std::string stack;
+
+		for(int frameNum = 0; frameNum < frameCount; ++frameNum) {
+#			if NODE_MODULE_VERSION >= 67 // >= Node.js 11
+				v8::Local<v8::StackFrame> frame = trace->GetFrame(isolate, frameNum);
+#			else
+				v8::Local<v8::StackFrame> frame = trace->GetFrame(frameNum);
+#			endif
+
+			Nan::Utf8String functionName(frame->GetFunctionName());
+			Nan::Utf8String scriptName(frame->GetScriptName());
+
+			stack += "    at ";
+			stack += functionName.length() ? *functionName : "<anonymous>";
+			stack += " (";
+			stack += scriptName.length() ? *scriptName : "<unknown>";
+			stack += ':' + std::to_string(frame->GetLineNumber());
+			stack += ':' + std::to_string(frame->GetColumn());
+			stack += ")\n";
+		}
+
+		return(stack);
+	}
+
+};
+
+} // namespace
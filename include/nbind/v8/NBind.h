@@ -56,6 +56,23 @@ public:
 
 	static External queryType(NBindID type, cbFunction &outTypeDetail);
 
+	static void getStringCacheStats(cbFunction &outStats);
+
+	static void getWrapperTableStats(cbFunction &outStats);
+
+	static void getClassStats(cbFunction &outStats);
+
+	static void getLiveObjects(cbFunction &outClass, cbFunction &outSite);
+
+	static void setAllocationSampling(unsigned int interval);
+
+#if defined(NBIND_PROFILE)
+	static void getCallStats(cbFunction &outCall);
+#endif
+
+	static void enterArena();
+	static void leaveArena();
+
 };
 
 } // namespace
@@ -32,9 +32,6 @@ public:
 	struct OverloadDef {
 		std::vector<funcPtr> methodVect;
 
-		// Constructor called by JavaScript's "new" operator.
-		Nan::Callback *constructorJS = nullptr;
-
 		jsMethod wrapPtr = nullptr;
 	};
 
@@ -72,6 +69,8 @@ public:
 	}
 
 	static void callConstructor(const Nan::FunctionCallbackInfo<v8::Value> &args) {
+		TraceSpan trace(args);
+
 		Status::clearError();
 
 		// Call C++ constructor and bind the resulting object
@@ -100,7 +99,7 @@ public:
 	}
 
 	static void callNew(const Nan::FunctionCallbackInfo<v8::Value> &args) {
-		OverloadDef &def = getDef(SignatureParam::get(args)->overloadNum);
+		Nan::Callback *constructorJS = getConstructorJS(SignatureParam::get(args)->overloadNum);
 
 		unsigned int argc = args.Length();
 		std::vector<v8::Local<v8::Value>> argv(argc);
@@ -112,7 +111,7 @@ public:
 			argv[argNum] = args[argNum];
 		}
 
-		v8::Local<v8::Function> constructor = def.constructorJS->GetFunction();
+		v8::Local<v8::Function> constructor = constructorJS->GetFunction();
 
 		// Call the JavaScript constructor with the new operator.
 		auto result = Nan::NewInstance(constructor, argc, (argc)?(&argv[0]):(nullptr));
@@ -132,7 +131,18 @@ public:
 	}
 
 	static void createValue(const Nan::FunctionCallbackInfo<v8::Value> &args) {
-		ArgStorage &storage = *static_cast<ArgStorage *>(Nan::GetInternalFieldPointer(args.Holder(), 0));
+		ArgStorage *storagePtr = static_cast<ArgStorage *>(Nan::GetInternalFieldPointer(args.Holder(), 0));
+
+		// The storage object is re-used between conversions.
+		// Fail if it was kept and called outside one.
+
+		if(storagePtr == nullptr) {
+			NBIND_ERR("Value constructor called outside conversion");
+			args.GetReturnValue().Set(Nan::Undefined());
+			return;
+		}
+
+		ArgStorage &storage = *storagePtr;
 		static std::vector<OverloadDef> &overloadVect = overloadVectStore();
 		OverloadDef &def = overloadVect[storage.getOverloadNum()];
 
@@ -146,7 +156,15 @@ public:
 			auto specializedCall = reinterpret_cast<createValueHandler>(methodVect[argc]);
 
 			if(specializedCall != nullptr) {
-				specializedCall(storage, args);
+				// Arguments with the wrong type throw before being converted,
+				// but exceptions can't pass through the JavaScript fromJS call.
+
+				try {
+					specializedCall(storage, args);
+				} catch(const std::exception &ex) {
+					NBIND_ERR(ex.what());
+				}
+
 				args.GetReturnValue().Set(Nan::Undefined());
 				return;
 			}
@@ -185,15 +203,26 @@ public:
 	}
 
 	static void setConstructorJS(unsigned int num, v8::Local<v8::Function> func) {
-		OverloadDef &def = getDef(num);
+		Nan::Callback *&constructorJS = getConstructorJS(num);
 
-		if(def.constructorJS == nullptr) {
-			def.constructorJS = new Nan::Callback(func);
+		if(constructorJS == nullptr) {
+			constructorJS = new Nan::Callback(func);
 		} else {
-			def.constructorJS->SetFunction(func);
+			constructorJS->SetFunction(func);
 		}
 	}
 
+	// Constructor called by JavaScript's "new" operator. Each thread running
+	// JavaScript has its own V8 isolate, and its own constructors.
+
+	static Nan::Callback *&getConstructorJS(unsigned int num) {
+		static thread_local std::vector<Nan::Callback *> constructorList;
+
+		if(num >= constructorList.size()) constructorList.resize(num + 1, nullptr);
+
+		return(constructorList[num]);
+	}
+
 	static void setPtrWrapper(unsigned int num, jsMethod wrapPtr) {
 		getDef(num).wrapPtr = wrapPtr;
 	}
@@ -0,0 +1,197 @@
+// This file is part of nbind, copyright (C) 2014-2016 BusFaster Ltd.
+// Released under the MIT license, see LICENSE.
+
+// This file handles profiling calls from JavaScript into C++,
+// enabled by defining NBIND_PROFILE.
+
+#pragma once
+
+#if defined(NBIND_PROFILE)
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace nbind {
+
+// Counters and times in nanoseconds for calls to a single bound function.
+
+struct ProfileEntry {
+
+	static NBIND_CONSTEXPR unsigned int bucketCount = 32;
+
+	uint64_t callCount = 0;
+	uint64_t exceptionCount = 0;
+
+	uint64_t totalTime = 0;
+	uint64_t argTime = 0;
+	uint64_t bodyTime = 0;
+	uint64_t returnTime = 0;
+
+	/** Bucket n counts calls taking from 2^n to 2^(n+1) nanoseconds.
+	  * The last one also counts any slower calls. */
+	uint64_t histogram[bucketCount] = {};
+
+};
+
+// Times a call, split into argument conversion, the C++ body and return
+// value conversion. Caller marks the boundaries between them. Calls back
+// into C++ from JavaScript callbacks are included in the body time of the
+// outer call.
+
+class ProfileScope {
+
+public:
+
+	typedef std::chrono::steady_clock Clock;
+
+	explicit ProfileScope(unsigned int entryNum) :
+		entryNum(entryNum),
+		parent(getCurrent()),
+		start(Clock::now()) {
+		getCurrent() = this;
+	}
+
+	ProfileScope(const ProfileScope &) = delete;
+	ProfileScope &operator=(const ProfileScope &) = delete;
+
+	~ProfileScope() {
+		Clock::time_point end = Clock::now();
+		ProfileEntry &entry = getEntry(entryNum);
+
+		// Missing marks mean the call failed or didn't reach the C++ body.
+
+		if(!hasArgs) argEnd = end;
+		if(!hasBody) bodyEnd = end;
+
+		uint64_t total = elapsed(start, end);
+
+		++entry.callCount;
+		if(failed) ++entry.exceptionCount;
+
+		entry.totalTime += total;
+		entry.argTime += elapsed(start, argEnd);
+		entry.bodyTime += elapsed(argEnd, bodyEnd);
+		entry.returnTime += elapsed(bodyEnd, end);
+
+		unsigned int bucket = 0;
+
+		while(total > 1 && bucket < ProfileEntry::bucketCount - 1) {
+			total >>= 1;
+			++bucket;
+		}
+
+		++entry.histogram[bucket];
+
+		getCurrent() = parent;
+	}
+
+	void fail() { failed = true; }
+
+	// Arguments are converted and the C++ body starts.
+
+	static void markArgs() {
+		ProfileScope *scope = getCurrent();
+
+		if(scope && !scope->hasArgs) {
+			scope->argEnd = Clock::now();
+			scope->hasArgs = true;
+		}
+	}
+
+	// The C++ body returned.
+
+	static void markBody() {
+		ProfileScope *scope = getCurrent();
+
+		if(scope && !scope->hasBody) {
+			scope->bodyEnd = Clock::now();
+			scope->hasBody = true;
+		}
+	}
+
+	// Allocate an entry for a bound function, in all threads.
+
+	static unsigned int addEntry() {
+		return(getEntryCount()++);
+	}
+
+	// Entries are separate for each thread running JavaScript.
+
+	static ProfileEntry &getEntry(unsigned int num) {
+		static thread_local std::vector<ProfileEntry> entryList;
+
+		if(num >= entryList.size()) entryList.resize(getEntryCount());
+
+		return(entryList[num]);
+	}
+
+private:
+
+	static uint64_t elapsed(Clock::time_point from, Clock::time_point to) {
+		return(std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count());
+	}
+
+	static ProfileScope *&getCurrent() {
+		static thread_local ProfileScope *current = nullptr;
+
+		return(current);
+	}
+
+	static std::atomic<unsigned int> &getEntryCount() {
+		static std::atomic<unsigned int> count(0);
+
+		return(count);
+	}
+
+	const unsigned int entryNum;
+	ProfileScope *parent;
+
+	Clock::time_point start;
+	Clock::time_point argEnd;
+	Clock::time_point bodyEnd;
+
+	bool hasArgs = false;
+	bool hasBody = false;
+	bool failed = false;
+
+};
+
+} // namespace
+
+#else
+
+namespace nbind {
+
+// Profiling is disabled, so everything compiles to nothing.
+
+class ProfileScope {
+
+public:
+
+	explicit ProfileScope(unsigned int) {}
+
+	void fail() {}
+
+	static void markArgs() {}
+	static void markBody() {}
+
+};
+
+} // namespace
+
+#endif // NBIND_PROFILE
+
+namespace nbind {
+
+// Marks the C++ body of a call while in scope.
+
+struct ProfileBody {
+
+	ProfileBody() { ProfileScope::markArgs(); }
+	~ProfileBody() { ProfileScope::markBody(); }
+
+};
+
+} // namespace
@@ -0,0 +1,91 @@
+// This file is part of nbind, copyright (C) 2014-2016 BusFaster Ltd.
+// Released under the MIT license, see LICENSE.
+
+#pragma once
+
+#include <node_version.h>
+
+namespace nbind {
+
+template <typename ArgType>
+struct BindingType<Span<ArgType>> {
+
+	typedef Span<ArgType> Type;
+
+	// Accept a typed array with matching members,
+	// or an ArrayBuffer holding a whole number of them.
+
+	static inline bool checkType(WireType arg) {
+#		if NODE_MODULE_VERSION >= 14 // Node.js 0.12
+			if(TypedArrayTraits<ArgType>::checkType(arg)) return(true);
+
+			if(arg->IsArrayBuffer()) {
+				return(arg.template As<v8::ArrayBuffer>()->ByteLength() % sizeof(ArgType) == 0);
+			}
+#		endif
+
+		return(false);
+	}
+
+	static inline Type fromWireType(WireType arg) {
+		v8::Local<v8::Object> obj = Nan::To<v8::Object>(arg).ToLocalChecked();
+		Type result(nullptr, 0, obj);
+
+#		if NODE_MODULE_VERSION >= 14 // Node.js 0.12
+			Buffer buf(nullptr, 0, obj);
+
+			BindingType<Buffer>::initFromArray(arg, buf);
+
+			result.ptr = reinterpret_cast<ArgType *>(buf.data());
+			result.len = buf.length() / sizeof(ArgType);
+#		endif
+
+		return(result);
+	}
+
+	// Return a typed array aliasing the memory. If the span came from
+	// JavaScript, the typed array keeps the original object alive.
+
+	static inline WireType toWireType(Type arg) {
+#		if NODE_MODULE_VERSION >= 14 // Node.js 0.12
+			WireType result = TypedArrayConverter<ArgType>::wrapMemory(arg.ptr, arg.len);
+
+			if(!arg.handle.isEmpty()) keepAlive(result, arg.handle.getHandle());
+
+			return(result);
+#		else
+			return(Nan::Null());
+#		endif
+	}
+
+	static inline void keepAlive(WireType view, v8::Local<v8::Object> owner) {
+		Nan::SetPrivate(
+			Nan::To<v8::Object>(view).ToLocalChecked(),
+			Nan::New<v8::String>("nbind:owner").ToLocalChecked(),
+			owner
+		);
+	}
+
+};
+
+// A span returned from a method usually points inside the object,
+// so the typed array keeps its wrapper alive.
+
+template <typename ArgType>
+struct MethodResultOwner<Span<ArgType>> {
+
+	template <typename NanArgs>
+	static inline WireType link(WireType result, NanArgs &args) {
+		if(result->IsObject()) {
+			BindingType<Span<ArgType>>::keepAlive(result, args.This());
+		}
+
+		return(result);
+	}
+
+};
+
+template <typename ArgType>
+inline void Span<ArgType> :: commit() {}
+
+} // namespace
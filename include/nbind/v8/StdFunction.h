@@ -26,7 +26,8 @@ template<typename PolicyList, size_t Index, typename ReturnType, typename... Arg
 struct ArgFromWire<PolicyList, Index, ArgType> {    \
                                                     \
 	template <typename NanArgs>                     \
-	ArgFromWire(const NanArgs &args) : val(cbWrapper<ReturnType>(args[Index].template As<v8::Function>())) {} \
+	ArgFromWire(const NanArgs &args) :              \
+		val(cbWrapper<ReturnType>(checkedArg<PolicyList, Index, ArgType>(args).template As<v8::Function>())) {} \
                                                     \
 	template <typename NanArgs>                     \
 	inline ArgType get(const NanArgs &args) {       \
@@ -0,0 +1,219 @@
+// This file is part of nbind, copyright (C) 2014-2016 BusFaster Ltd.
+// Released under the MIT license, see LICENSE.
+
+// This file handles returning strings to JavaScript without copying them
+// (StaticString policy) and re-using JavaScript strings for repeated
+// return values (Interned policy).
+
+#pragma once
+
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace nbind {
+
+// String in static memory, seen by JavaScript without copying.
+// V8 deletes this resource object but never touches the string contents.
+
+class StaticStringResource : public Nan::ExternalOneByteStringResource {
+
+public:
+
+	StaticStringResource(const char *str, size_t len) : str(str), len(len) {}
+
+	const char *data() const override { return(str); }
+
+	size_t length() const override { return(len); }
+
+private:
+
+	const char *str;
+	size_t len;
+
+};
+
+class StringCache {
+
+public:
+
+	// Stop adding strings after this many, to avoid growing without limit
+	// if a policy is applied to an unexpectedly large set of strings.
+
+	static NBIND_CONSTEXPR size_t maxSize = 4096;
+
+	// Get a string in static memory, cached by its address.
+	// The string is not copied if it's plain ASCII.
+
+	static v8::Local<v8::String> getStatic(const char *str) {
+		auto &tbl = getStaticTbl();
+		auto pos = tbl.find(str);
+
+		if(pos != tbl.end()) {
+			++getStats().hits;
+			return(Nan::New(pos->second));
+		}
+
+		++getStats().misses;
+
+		v8::Local<v8::String> result = makeStatic(str, strlen(str));
+
+		if(tbl.size() < maxSize) tbl[str].Reset(result);
+
+		return(result);
+	}
+
+	// Get a string with any address, cached by its contents.
+	// Lookups hash the contents in place, so the string only gets
+	// copied when it's added to the cache.
+
+	static v8::Local<v8::String> getInterned(const char *str, size_t len) {
+		auto &tbl = getInternedTbl();
+		size_t key = hash(str, len);
+		auto pos = tbl.find(key);
+
+		if(pos != tbl.end()) {
+			for(auto &entry : pos->second) {
+				if(entry.text.length() == len && !memcmp(entry.text.data(), str, len)) {
+					++getStats().hits;
+					return(Nan::New(entry.handle));
+				}
+			}
+		}
+
+		++getStats().misses;
+
+		v8::Local<v8::String> result = Nan::New<v8::String>(str, len).ToLocalChecked();
+
+		if(getInternedCount() < maxSize) {
+			auto &bucket = tbl[key];
+
+			bucket.emplace_back(std::string(str, len));
+			bucket.back().handle.Reset(result);
+			++getInternedCount();
+		}
+
+		return(result);
+	}
+
+	// Point a new JavaScript string to a string in static memory.
+	// External one-byte strings are Latin-1 but C++ strings are assumed
+	// to be UTF-8, so only pure ASCII can be used without copying.
+
+	static v8::Local<v8::String> makeStatic(const char *str, size_t len) {
+		for(size_t pos = 0; pos < len; ++pos) {
+			if(str[pos] & 0x80) return(Nan::New<v8::String>(str, len).ToLocalChecked());
+		}
+
+		return(Nan::New<v8::String>(new StaticStringResource(str, len)).ToLocalChecked());
+	}
+
+	struct Stats {
+		uint32_t hits;
+		uint32_t misses;
+	};
+
+	static Stats &getStats() {
+		static thread_local Stats stats = { 0, 0 };
+
+		return(stats);
+	}
+
+	static size_t size() {
+		return(getStaticTbl().size() + getInternedCount());
+	}
+
+private:
+
+	struct InternedEntry {
+		explicit InternedEntry(std::string &&text) : text(std::move(text)) {}
+
+		InternedEntry(InternedEntry &&other) : text(std::move(other.text)) {
+			handle.Reset(Nan::New(other.handle));
+			other.handle.Reset();
+		}
+
+		std::string text;
+		Nan::Persistent<v8::String> handle;
+	};
+
+	// FNV-1a hash of the string contents.
+
+	static size_t hash(const char *str, size_t len) {
+		uint32_t result = 2166136261u;
+
+		for(size_t pos = 0; pos < len; ++pos) {
+			result = (result ^ static_cast<unsigned char>(str[pos])) * 16777619u;
+		}
+
+		return(result);
+	}
+
+	static std::unordered_map<const char *, Nan::Persistent<v8::String>> &getStaticTbl() {
+		static thread_local std::unordered_map<const char *, Nan::Persistent<v8::String>> staticTbl;
+
+		return(staticTbl);
+	}
+
+	// Strings bucketed by hash of their contents.
+
+	static std::unordered_map<size_t, std::vector<InternedEntry>> &getInternedTbl() {
+		static thread_local std::unordered_map<size_t, std::vector<InternedEntry>> internedTbl;
+
+		return(internedTbl);
+	}
+
+	static size_t &getInternedCount() {
+		static thread_local size_t count = 0;
+
+		return(count);
+	}
+
+};
+
+// C strings returned without copying (StaticString policy).
+
+template <typename ArgType>
+struct BindingType<StaticStringType<ArgType>> : public BindingType<ArgType> {
+
+	typedef typename BindingType<ArgType>::Type Type;
+
+	static inline WireType toWireType(Type arg) {
+		if(arg == nullptr) return(Nan::EmptyString());
+
+		return(StringCache::getStatic(reinterpret_cast<const char *>(arg)));
+	}
+
+};
+
+// Strings returned as cached JavaScript strings (Interned policy).
+
+template <typename ArgType>
+struct BindingType<InternedType<ArgType>> : public BindingType<ArgType> {
+
+	typedef typename BindingType<ArgType>::Type Type;
+
+	static inline WireType toWireType(Type arg) {
+		return(intern(arg));
+	}
+
+private:
+
+	static inline WireType intern(const std::string &arg) {
+		return(StringCache::getInterned(arg.data(), arg.length()));
+	}
+
+	static inline WireType intern(const unsigned char *arg) {
+		return(intern(reinterpret_cast<const char *>(arg)));
+	}
+
+	static inline WireType intern(const char *arg) {
+		const char *buf = (arg == nullptr) ? "" : arg;
+
+		return(StringCache::getInterned(buf, strlen(buf)));
+	}
+
+};
+
+} // namespace
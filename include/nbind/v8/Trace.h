@@ -0,0 +1,116 @@
+// This file is part of nbind, copyright (C) 2014-2016 BusFaster Ltd.
+// Released under the MIT license, see LICENSE.
+
+// This file handles trace events for crossings between JavaScript and C++,
+// in the "nbind" category of Node.js trace_events.
+
+#pragma once
+
+#include <cstdint>
+
+namespace nbind {
+
+#if NODE_MODULE_VERSION >= 72 // >= Node.js 12
+
+// TraceSpan emits a begin event when constructed and a matching end event
+// when destroyed, if the category is enabled, for example by running:
+// node --trace-event-categories nbind
+// Names must be string constants, because events are written out later.
+
+class TraceSpan {
+
+public:
+
+	TraceSpan(const char *className, const char *name) {
+		if(isEnabled()) begin(className, name);
+	}
+
+	// Take names from the SignatureParam of a bound function.
+	// Defined in SignatureParam.h.
+
+	template <typename InfoType>
+	explicit TraceSpan(const InfoType &args);
+
+	TraceSpan(const TraceSpan &) = delete;
+	TraceSpan &operator=(const TraceSpan &) = delete;
+
+	~TraceSpan() {
+		if(name != nullptr) emit('E', nullptr, name);
+	}
+
+	static bool isEnabled() { return(*getFlag() != 0); }
+
+private:
+
+	void begin(const char *className, const char *name) {
+		this->name = name;
+
+		emit('B', className, name);
+	}
+
+	static void emit(char phase, const char *className, const char *name) {
+		const char *argNames[] = { "class" };
+		// TRACE_VALUE_TYPE_STRING from V8's trace_event_common.h.
+		const uint8_t argTypes[] = { 6 };
+		const uint64_t argValues[] = {
+			static_cast<uint64_t>(reinterpret_cast<uintptr_t>(className))
+		};
+
+		node::GetTracingController()->AddTraceEvent(
+			phase,
+			getFlag(),
+			name,
+			nullptr,
+			0,
+			0,
+			className ? 1 : 0,
+			argNames,
+			argTypes,
+			argValues,
+			nullptr,
+			0
+		);
+	}
+
+	// V8 updates the flag when tracing starts or stops,
+	// so it can be checked on every call.
+
+	static const uint8_t *getFlag() {
+		static const uint8_t *flag = initFlag();
+
+		return(flag);
+	}
+
+	static const uint8_t *initFlag() {
+		static const uint8_t disabled = 0;
+		v8::TracingController *controller = node::GetTracingController();
+
+		if(controller == nullptr) return(&disabled);
+
+		return(controller->GetCategoryGroupEnabled("nbind"));
+	}
+
+	const char *name = nullptr;
+
+};
+
+#else
+
+// Trace events are unavailable, so everything compiles to nothing.
+
+class TraceSpan {
+
+public:
+
+	TraceSpan(const char *className, const char *name) {}
+
+	template <typename InfoType>
+	explicit TraceSpan(const InfoType &args) {}
+
+	static bool isEnabled() { return(false); }
+
+};
+
+#endif // NODE_MODULE_VERSION
+
+} // namespace
@@ -0,0 +1,160 @@
+// This file is part of nbind, copyright (C) 2014-2016 BusFaster Ltd.
+// Released under the MIT license, see LICENSE.
+
+// This file handles bulk copying between typed arrays and
+// C++ arrays or vectors of matching numeric types.
+
+#pragma once
+
+#include <memory>
+#include <type_traits>
+
+#include <node_version.h>
+
+namespace nbind {
+
+// Types without a matching typed array.
+
+template <typename ArgType>
+struct TypedArrayTraits {
+	static constexpr bool isTyped = false;
+
+	static inline bool checkType(WireType arg) {
+		return(false);
+	}
+};
+
+#if NODE_MODULE_VERSION >= 14 // >= Node.js 0.12
+
+#define DEFINE_TYPED_ARRAY_TRAITS(ArgType, jsClass, checker) \
+template <> struct TypedArrayTraits<ArgType> {               \
+	static constexpr bool isTyped = true;                    \
+	typedef v8::jsClass JSType;                              \
+	                                                         \
+	static inline bool checkType(WireType arg) {             \
+		return(checker);                                     \
+	}                                                        \
+}
+
+DEFINE_TYPED_ARRAY_TRAITS(double, Float64Array, arg->IsFloat64Array());
+DEFINE_TYPED_ARRAY_TRAITS(float, Float32Array, arg->IsFloat32Array());
+
+DEFINE_TYPED_ARRAY_TRAITS(unsigned int, Uint32Array, arg->IsUint32Array());
+DEFINE_TYPED_ARRAY_TRAITS(unsigned short, Uint16Array, arg->IsUint16Array());
+DEFINE_TYPED_ARRAY_TRAITS(unsigned char, Uint8Array, arg->IsUint8Array() || arg->IsUint8ClampedArray());
+
+DEFINE_TYPED_ARRAY_TRAITS(signed int, Int32Array, arg->IsInt32Array());
+DEFINE_TYPED_ARRAY_TRAITS(signed short, Int16Array, arg->IsInt16Array());
+DEFINE_TYPED_ARRAY_TRAITS(signed char, Int8Array, arg->IsInt8Array());
+
+// Create an ArrayBuffer pointing to C++ memory, which must outlive it.
+// Newer V8 needs a backing store with a deleter, here doing nothing
+// because the memory stays owned by C++. Each call gets its own backing
+// store, so the same memory can be wrapped more than once.
+
+static inline v8::Local<v8::ArrayBuffer> wrapExternalMemory(void *ptr, size_t len) {
+#	if NODE_MODULE_VERSION >= 83 // >= Node.js 14
+		std::shared_ptr<v8::BackingStore> store = v8::ArrayBuffer::NewBackingStore(
+			ptr,
+			len,
+			[](void *, size_t, void *) {},
+			nullptr
+		);
+
+		return(v8::ArrayBuffer::New(v8::Isolate::GetCurrent(), std::move(store)));
+#	else
+		return(v8::ArrayBuffer::New(v8::Isolate::GetCurrent(), ptr, len));
+#	endif
+}
+
+#endif // >= Node.js 0.12
+
+template <typename ArgType, bool isTyped = TypedArrayTraits<ArgType>::isTyped>
+struct TypedArrayConverter {
+
+	static inline bool checkType(WireType arg) {
+		return(false);
+	}
+
+	static inline size_t getLength(WireType arg) {
+		return(0);
+	}
+
+	template <typename Container>
+	static inline void copyFromWire(WireType arg, Container &val, size_t count) {}
+
+	template <typename Container>
+	static inline WireType toWireType(Container &&arg) {
+		// No matching typed array, so fall back to a normal array.
+		return(BindingType<typename std::remove_reference<Container>::type>::toWireType(std::move(arg)));
+	}
+
+#if NODE_MODULE_VERSION >= 14 // >= Node.js 0.12
+
+	// Show C++ memory to JavaScript as a plain ArrayBuffer without copying.
+
+	static inline WireType wrapMemory(ArgType *ptr, size_t count) {
+		return(wrapExternalMemory(ptr, count * sizeof(ArgType)));
+	}
+
+#endif // >= Node.js 0.12
+
+};
+
+template <typename ArgType>
+struct TypedArrayConverter<ArgType, true> {
+
+	typedef typename TypedArrayTraits<ArgType>::JSType JSType;
+
+	static inline bool checkType(WireType arg) {
+		return(TypedArrayTraits<ArgType>::checkType(arg));
+	}
+
+	static inline size_t getLength(WireType arg) {
+		return(arg.template As<JSType>()->Length());
+	}
+
+	// Copy up to count elements from a typed array.
+
+	template <typename Container>
+	static inline void copyFromWire(WireType arg, Container &val, size_t count) {
+		Nan::TypedArrayContents<ArgType> contents(arg);
+
+		if(contents.length() < count) count = contents.length();
+		if(count) memcpy(val.data(), *contents, count * sizeof(ArgType));
+	}
+
+	static inline void copyFromWire(WireType arg, std::vector<ArgType> &val, size_t count) {
+		val.resize(count);
+		copyFromWire<std::vector<ArgType>>(arg, val, count);
+	}
+
+	static inline WireType copyToWire(const ArgType *src, size_t count) {
+		v8::Local<v8::ArrayBuffer> buf = v8::ArrayBuffer::New(
+			v8::Isolate::GetCurrent(),
+			count * sizeof(ArgType)
+		);
+
+		v8::Local<JSType> arr = JSType::New(buf, 0, count);
+		Nan::TypedArrayContents<ArgType> contents(arr);
+
+		if(count) memcpy(*contents, src, count * sizeof(ArgType));
+
+		return(arr);
+	}
+
+	template <typename Container>
+	static inline WireType toWireType(Container &&arg) {
+		return(copyToWire(arg.data(), arg.size()));
+	}
+
+	// Show C++ memory to JavaScript as a typed array without copying.
+	// The memory must outlive the typed array.
+
+	static inline WireType wrapMemory(ArgType *ptr, size_t count) {
+		return(JSType::New(wrapExternalMemory(ptr, count * sizeof(ArgType)), 0, count));
+	}
+
+};
+
+} // namespace
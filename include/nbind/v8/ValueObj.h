@@ -10,27 +10,37 @@
 
 namespace nbind {
 
+// Attach a pointer returned from C++ to a new JavaScript object.
+
 template <typename BaseType, typename ArgType>
 struct ExternalPtr;
 
 template <typename BaseType, typename ArgType>
 struct ExternalPtr<BaseType, ArgType *> {
-	static void *make(ArgType *arg) {
-		return(const_cast<BaseType *>(arg));
+	static void wrap(v8::Local<v8::Object> obj, ArgType *arg, TypeFlags flags) {
+		BindWrapper<BaseType>::wrapNew(obj, const_cast<BaseType *>(arg), flags);
 	}
 };
 
 template <typename BaseType, typename ArgType>
 struct ExternalPtr<BaseType, std::shared_ptr<ArgType>> {
-	static void *make(std::shared_ptr<ArgType> &&ptr) {
-		return(new std::shared_ptr<ArgType>(std::move(ptr)));
+	static void wrap(v8::Local<v8::Object> obj, std::shared_ptr<ArgType> &&ptr, TypeFlags flags) {
+		BindWrapper<BaseType>::wrapNew(
+			obj,
+			std::const_pointer_cast<BaseType>(std::move(ptr)),
+			flags
+		);
 	}
 };
 
 template <typename BaseType, typename ArgType>
 struct ExternalPtr<BaseType, std::unique_ptr<ArgType>> {
-	static void *make(std::shared_ptr<ArgType> &&ptr) {
-		return(new std::shared_ptr<ArgType>(std::move(ptr)));
+	static void wrap(v8::Local<v8::Object> obj, std::shared_ptr<ArgType> &&ptr, TypeFlags flags) {
+		BindWrapper<BaseType>::wrapNew(
+			obj,
+			std::const_pointer_cast<BaseType>(std::move(ptr)),
+			flags
+		);
 	}
 };
 
@@ -40,36 +50,64 @@ static inline WireType makeExternal(TypeFlags flags, TargetType *ptr, ArgType &&
 
 #ifndef NBIND_DUPLICATE_POINTERS
 
-	auto ref = BindWrapper<BaseType>::findInstance(ptr, flags);
+	BindWrapperBase *wrapper = BindWrapperBase::findInstance(ptr, flags);
 
-	if(!ref->IsEmpty()) {
-		return(Nan::New<v8::Object>(*ref));
+	if(wrapper != nullptr && !wrapper->persistent().IsEmpty()) {
+		return(wrapper->handle());
 	}
 
 #endif // NBIND_DUPLICATE_POINTERS
 
-	unsigned int constructorNum = BindClass<BaseType>::getInstance().wrapperConstructorNum;
-	Nan::Callback *constructorJS = Overloader::getDef(constructorNum).constructorJS;
+	v8::Local<v8::ObjectTemplate> instanceTemplate = BindClass<BaseType>::getInstance().getInstanceTemplate();
+
+	if(instanceTemplate.IsEmpty()) {
+		Nan::ThrowError("Unbound type");
+		return(Nan::Undefined());
+	}
+
+	// Instantiate the object template of the class directly, so the
+	// JavaScript constructor and overload resolution are skipped.
+
+	v8::Local<v8::Object> obj;
+
+	if(!Nan::NewInstance(instanceTemplate).ToLocal(&obj)) {
+		return(Nan::Undefined());
+	}
+
+	ExternalPtr<BaseType, ArgType>::wrap(obj, std::move(arg), flags);
 
-	if(constructorJS == nullptr) {
+	return(obj);
+}
+
+template <typename ArgType>
+WireType makeValueWrapper(ArgType &&arg, std::false_type isInline) {
+	return(BindingType<std::shared_ptr<ArgType>>::toWireType(
+		// Move construct from stack to heap.
+		std::make_shared<ArgType>(std::move(arg))
+	));
+}
+
+template <typename ArgType>
+WireType makeValueWrapper(ArgType &&arg, std::true_type isInline) {
+	v8::Local<v8::ObjectTemplate> instanceTemplate = BindClass<ArgType>::getInstance().getInstanceTemplate();
+
+	if(instanceTemplate.IsEmpty()) {
 		Nan::ThrowError("Unbound type");
 		return(Nan::Undefined());
 	}
 
-	v8::Local<v8::Function> constructor = constructorJS->GetFunction();
+	v8::Local<v8::Object> obj;
 
-	// TODO: first argument should be a unique marker of some kind.
+	if(!Nan::NewInstance(instanceTemplate).ToLocal(&obj)) {
+		return(Nan::Undefined());
+	}
 
-	const unsigned int argc = 2;
-	v8::Local<v8::Value> argv[] = {
-		Nan::New<v8::External>(ExternalPtr<BaseType, ArgType>::make(std::move(arg))),
-		Nan::New<v8::Uint32>(static_cast<uint32_t>(flags))
-	};
+	// Move construct from stack into the same allocation as the wrapper.
+	// The address is new, so there's no need to look for an existing wrapper.
 
-	// This will try to call the C++ constructor, so Overloader or Creator
-	// needs to detect the argument is a v8::External and just wrap it instead.
+	InlineBindWrapper<ArgType>::wrapNew(obj, TypeFlags::isSharedPtr, std::move(arg));
 
-	return(Nan::NewInstance(constructor, argc, argv).ToLocalChecked());
+	return(obj);
 }
 
 template <typename ArgType>
@@ -109,24 +147,90 @@ template <> struct BindingType<v8::Local<v8::Object>> {
 
 };
 
+template <class Bound>
+bool fieldsToWire(const Bound &arg, v8::Local<v8::Value> &output) {
+	BindClassBase &bindClass = BindClass<Bound>::getInstance();
+	auto &fieldList = bindClass.getFieldList();
+
+	if(fieldList.empty()) return(false);
+
+	// Make the object an instance of the JavaScript value class, if bound,
+	// without running its constructor.
+
+	v8::Local<v8::Function> constructor = bindClass.getFieldConstructor();
+	v8::Local<v8::Object> obj;
+
+	if(!constructor.IsEmpty()) {
+		obj = Nan::NewInstance(constructor).ToLocalChecked();
+	} else {
+		obj = Nan::NewInstance(bindClass.getFieldTemplate()).ToLocalChecked();
+	}
+
+	for(auto *field : fieldList) Nan::Set(obj, field->getKey(), field->read(&arg));
+
+	output = obj;
+	return(true);
+}
+
+// Read fields listed in NBIND_CLASS from any JavaScript object
+// into a default-constructed C++ object. All fields must be present.
+
+template <typename ArgType>
+ArgType fieldsFromWire(
+	v8::Local<v8::Object> target,
+	BindClassBase &bindClass,
+	std::true_type isDefaultConstructible
+) {
+	ArgType result;
+
+	for(auto *field : bindClass.getFieldList()) {
+		v8::Local<v8::Value> value;
+
+		if(
+			!Nan::Get(target, field->getKey()).ToLocal(&value) ||
+			value->IsUndefined() ||
+			!field->write(&result, value)
+		) {
+			throw(std::runtime_error("Type mismatch"));
+		}
+	}
+
+	return(result);
+}
+
+template <typename ArgType>
+ArgType fieldsFromWire(
+	v8::Local<v8::Object> target,
+	BindClassBase &bindClass,
+	std::false_type isDefaultConstructible
+) {
+	throw(std::runtime_error("Value type with fields needs a default constructor"));
+}
+
 template <typename ArgType>
 inline ArgType BindingType<ValueType<ArgType>>::fromWireType(WireType arg) noexcept(false) {
 	auto target = Nan::To<v8::Object>(arg).ToLocalChecked();
-	auto fromJS = target->Get(Nan::New<v8::String>("fromJS").ToLocalChecked());
-
-	if(!fromJS->IsFunction()) throw(std::runtime_error("Type mismatch"));
 
 	BindClassBase &bindClass = BindClass<ArgType>::getInstance();
+	TraceSpan trace(bindClass.getName(), "fromJS");
+
+	if(!bindClass.getFieldList().empty()) {
+		return(fieldsFromWire<ArgType>(
+			target,
+			bindClass,
+			typename std::is_default_constructible<ArgType>::type()
+		));
+	}
 
 	TemplatedArgStorage<ArgType> storage(bindClass.valueConstructorNum);
 
-	auto instance = Nan::NewInstance(Nan::New(bindClass.storageTemplate)).ToLocalChecked();
-	// Data specifically for createValue function.
-	Nan::SetInternalFieldPointer(instance, 0, &storage);
+	// Pass data specifically for createValue function.
 
-	// TODO: cache this for a speedup.
-	cbFunction converter(v8::Local<v8::Function>::Cast(fromJS));
-	converter.callMethod<void>(target, instance);
+	ClassState &state = bindClass.getState();
+
+	if(!state.valueCache.callFromJS(target, Nan::New(state.storageTemplate), &storage)) {
+		throw(std::runtime_error("Type mismatch"));
+	}
 
 	const char *message = Status::getError();
 	if(message) throw(std::runtime_error(message));
@@ -33,7 +33,12 @@ export interface TypeSpecWithSize extends TypeSpecWithName {
 export interface TypeClass extends TypeSpec {
 	toString?(): string;
 
-	makeWireRead?(expr: string, convertParamList?: any[], num?: number): string;
+	makeWireRead?(
+		expr: string,
+		policyTbl: PolicyTbl | null,
+		convertParamList?: any[],
+		num?: number
+	): string;
 	makeWireWrite?(
 		expr: string,
 		policyTbl: PolicyTbl | null,
@@ -88,7 +93,8 @@ export const enum TypeFlags {
 	isCString = TypeFlagBase.kind * 7,
 	isString = TypeFlagBase.kind * 8,
 	isCallback = TypeFlagBase.kind * 9,
-	isOther = TypeFlagBase.kind * 10
+	isOther = TypeFlagBase.kind * 10,
+	isSpan = TypeFlagBase.kind * 11
 }
 
 export const enum StateFlags {
@@ -111,6 +117,7 @@ export const enum StructureType {
 	vector,
 	array,
 	callback,
+	span,
 	max
 }
 
@@ -130,7 +137,8 @@ export function typeModule(self: any) {
 		[TypeFlags.isUniquePtr, 1, 'std::unique_ptr<X>'],
 		[TypeFlags.isVector, 1, 'std::vector<X>'],
 		[TypeFlags.isArray, 2, 'std::array<X, Y>'],
-		[TypeFlags.isCallback, -1, 'std::function<X (Y)>']
+		[TypeFlags.isCallback, -1, 'std::function<X (Y)>'],
+		[TypeFlags.isSpan, 1, 'nbind::Span<X>']
 	];
 
 	function applyStructure(
@@ -8,8 +8,8 @@ using namespace nbind;
 // const char *nbind :: emptyGetter = ""; unused for now.
 const char *nbind :: emptySetter = "";
 
-// Linkage for module-wide error message.
-char *Status :: message;
+// Linkage for error message, separate for each thread.
+thread_local char *Status :: message;
 
 void NBind :: bind_value(const char *name, cbFunction &func) {
 	for(auto *bindClass : getClassList()) {
@@ -99,6 +99,9 @@ const void **nbind :: getNamedTypeList() {
 		NBIND_TYPE(void),
 		NBIND_TYPE(bool),
 		NBIND_TYPE(std::string),
+#		if defined(NBIND_STRING_VIEW)
+			NBIND_TYPE(std::string_view),
+#		endif
 		// NBIND_TYPE(cbFunction),
 		NBIND_TYPE(cbFunction &),
 		NBIND_TYPE(const cbFunction &),
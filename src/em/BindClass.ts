@@ -31,6 +31,8 @@ export namespace _nbind {
 
 	export let makeCaller: typeof _caller.makeCaller;
 	export let makeMethodCaller: typeof _caller.makeMethodCaller;
+	export let makeBatch: typeof _caller.makeBatch;
+	export let makeAsync: typeof _caller.makeAsync;
 
 	type Wrapper = _wrapper.Wrapper;
 	export let makeBound: typeof _wrapper.makeBound;
@@ -112,6 +114,13 @@ export namespace _nbind {
 						// tslint:disable-next-line:no-switch-case-fall-through
 						case SignatureType.construct:
 							caller = makeCaller(spec);
+
+							if(spec.signatureType == SignatureType.func) {
+								if(spec.policyTbl && spec.policyTbl['Async']) caller = makeAsync(caller);
+
+								caller.batch = makeBatch(caller, spec, false);
+							}
+
 							addMethod(target, spec.name, caller, spec.typeList!.length - 1);
 							break;
 
@@ -130,6 +139,8 @@ export namespace _nbind {
 
 						case SignatureType.method:
 							caller = makeMethodCaller(src.ptrType, spec);
+							if(spec.policyTbl && spec.policyTbl['Async']) caller = makeAsync(caller);
+							caller.batch = makeBatch(caller, spec, true);
 							addMethod(target, spec.name, caller, spec.typeList!.length - 1);
 							break;
 
@@ -220,6 +231,9 @@ export namespace _nbind {
 
 		destroy: (shared: number, flags: number) => void;
 
+		/** sizeof the C++ class. */
+		size = 0;
+
 		/** Number of super classes left to initialize. */
 		pendingSuperCount = 0;
 
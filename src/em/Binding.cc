@@ -18,7 +18,8 @@ extern "C" {
 		const char **policies, const TYPEID *superList, void *(**upcastList)(void *),
 		unsigned int superCount,
 		funcPtr destructor,
-		const char *name
+		const char *name,
+		unsigned int size
 	);
 	extern void _nbind_register_function(TYPEID boundID,
 		const char **policies, const TYPEID *types, unsigned int typeCount,
@@ -26,6 +27,7 @@ extern "C" {
 		const char *name, unsigned int num, unsigned int flags
 	);
 	extern void _nbind_finish();
+	extern void _nbind_enable_profile();
 }
 
 unsigned int Pool::used = 0;
@@ -97,6 +99,20 @@ void NBind :: lreset(unsigned int used, uintptr_t page) {
 	Pool::used = used;
 }
 
+void NBind :: enterArena() {
+	Arena::enter();
+}
+
+void NBind :: leaveArena() {
+	Arena::leave();
+}
+
+bool NBind :: arenaOwns(uintptr_t ptr) {
+	Arena *arena = Arena::getCurrent();
+
+	return(arena != nullptr && arena->owns(reinterpret_cast<void *>(ptr)));
+}
+
 NBindID :: NBindID(TYPEID id) : id(id) {}
 NBindID :: NBindID(uintptr_t ptr) : id(reinterpret_cast<TYPEID>(ptr)) {}
 
@@ -127,6 +143,11 @@ typedef BaseSignature :: SignatureType SignatureType;
 static void initModule() {
 	_nbind_register_pool(Pool::pageSize, &Pool::used, Pool::rootPage, &Pool::page);
 
+#	if defined(NBIND_PROFILE)
+		// Invokers of functions registered later will be profiled.
+		_nbind_enable_profile();
+#	endif
+
 	const void **primitiveData = getPrimitiveList();
 	const uint8_t *sizePtr = static_cast<const uint8_t *>(primitiveData[1]);
 	const uint8_t *flagPtr = static_cast<const uint8_t *>(primitiveData[2]);
@@ -184,7 +205,8 @@ static void initModule() {
 			upcastList,
 			bindClass->getSuperClassCount(),
 			bindClass->getDeleter(),
-			bindClass->getName()
+			bindClass->getName(),
+			static_cast<unsigned int>(bindClass->getSize())
 		);
 	}
 
@@ -304,6 +326,10 @@ NBIND_CLASS(NBind) {
 
 	method(lalloc);
 	method(lreset);
+
+	method(enterArena);
+	method(leaveArena);
+	method(arenaOwns);
 }
 
 NBIND_CLASS(NBindID) {
@@ -22,6 +22,13 @@ export namespace _nbind {
 
 	export let resources: typeof _resource.resources;
 
+	/** Offset of array contents after the 32-bit length,
+	  * matching alignment of the C++ wire type struct. */
+
+	function getDataOffset(ptrSize: number) {
+		return(ptrSize > 4 ? ptrSize : 4);
+	}
+
 	export function pushArray(arr: any[], type: ArrayType) {
 		if(!arr) return(0);
 
@@ -32,12 +39,13 @@ export namespace _nbind {
 		}
 
 		const ptrSize = type.memberType.ptrSize;
-		const result = Pool.lalloc(4 + length * ptrSize);
+		const offset = getDataOffset(ptrSize);
+		const result = Pool.lalloc(offset + length * ptrSize);
 
 		HEAPU32[result / 4] = length;
 
 		const heap = type.memberType.heap;
-		let ptr = (result + 4) / ptrSize;
+		let ptr = (result + offset) / ptrSize;
 
 		const wireWrite = type.memberType.wireWrite;
 		let num = 0;
@@ -47,9 +55,8 @@ export namespace _nbind {
 				heap[ptr++] = wireWrite(arr[num++]);
 			}
 		} else {
-			while(num < length) {
-				heap[ptr++] = arr[num++];
-			}
+			// Copy numbers (possibly from a typed array) in bulk.
+			heap.set(arr, ptr);
 		}
 
 		return(result);
@@ -62,7 +69,8 @@ export namespace _nbind {
 		const arr = new Array(length);
 
 		const heap = type.memberType.heap;
-		ptr = (ptr + 4) / type.memberType.ptrSize;
+		const ptrSize = type.memberType.ptrSize;
+		ptr = (ptr + getDataOffset(ptrSize)) / ptrSize;
 
 		const wireRead = type.memberType.wireRead;
 		let num = 0;
@@ -80,6 +88,21 @@ export namespace _nbind {
 		return(arr);
 	}
 
+	/** Read a C++ array or vector of numbers into a new typed array
+	  * (TypedArray policy). */
+
+	export function popTypedArray(ptr: number, type: ArrayType) {
+		if(ptr === 0) return(null);
+
+		const length = HEAPU32[ptr / 4];
+		const heap = type.memberType.heap;
+		const ptrSize = type.memberType.ptrSize;
+
+		ptr = (ptr + getDataOffset(ptrSize)) / ptrSize;
+
+		return(new heap.constructor(heap.subarray(ptr, ptr + length)));
+	}
+
 	export class ArrayType extends BindType {
 		constructor(spec: TypeSpecWithParam) {
 			super(spec);
@@ -88,16 +111,25 @@ export namespace _nbind {
 			if(spec.paramList[1]) this.size = spec.paramList[1] as number;
 		}
 
+		makeWireRead(expr: string, policyTbl: PolicyTbl | null, convertParamList: any[], num: number) {
+			const memberType = this.memberType;
+
+			convertParamList[num] = (
+				policyTbl && (policyTbl['TypedArray'] || policyTbl['Bytes']) &&
+				memberType.heap && !memberType.needsWireRead(null) ?
+				(arg: number) => popTypedArray(arg, this) :
+				this.wireRead
+			);
+
+			return('(convertParamList[' + num + '](' + expr + '))');
+		}
+
 		wireRead = (arg: number) => popArray(arg, this);
 		wireWrite = (arg: any) => pushArray(arg, this);
 
 		// Optional type conversion code
 		/*
-		makeWireRead = (expr: string, convertParamList: any[], num: number) => {
-			convertParamList[num] = this;
-			return('_nbind.popArray(' + expr + ',convertParamList[' + num + '])');
-		};
-		makeWireWrite = (expr: string, convertParamList: any[], num: number) => {
+		makeWireWrite = (expr: string, policyTbl: PolicyTbl | null, convertParamList: any[], num: number) => {
 			convertParamList[num] = this;
 			return('_nbind.pushArray(' + expr + ',convertParamList[' + num + '])');
 		};
@@ -142,7 +174,27 @@ export namespace _nbind {
 		return(Module.Pointer_stringify(ptr + 4, length));
 	}
 
+	/** Copy string contents into a Uint8Array without decoding (Bytes policy). */
+
+	export function popBytes(ptr: number) {
+		if(ptr === 0) return(null);
+
+		const length = HEAPU32[ptr / 4];
+
+		return(new Uint8Array(HEAPU8.subarray(ptr + 4, ptr + 4 + length)));
+	}
+
 	export class StringType extends BindType {
+		makeWireRead(expr: string, policyTbl: PolicyTbl | null, convertParamList: any[], num: number) {
+			convertParamList[num] = (
+				policyTbl && policyTbl['Bytes'] ?
+				popBytes :
+				this.wireRead
+			);
+
+			return('(convertParamList[' + num + '](' + expr + '))');
+		}
+
 		makeWireWrite(expr: string, policyTbl: PolicyTbl) {
 			return((arg: any) => pushString(arg, policyTbl));
 		}
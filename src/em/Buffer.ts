@@ -6,7 +6,7 @@ import { _nbind as _globals } from './Globals';
 import { _nbind as _type } from './BindingType';
 import { _nbind as _external } from './External';
 import { _nbind as _resource } from './Resource';
-import { PolicyTbl } from '../Type';
+import { PolicyTbl, TypeSpecWithParam } from '../Type';
 
 // Let decorators run eval in current scope to read function source code.
 setEvil((code: string) => eval(code));
@@ -14,6 +14,7 @@ setEvil((code: string) => eval(code));
 export namespace _nbind {
 	export const Pool = _globals.Pool;
 	export const BindType = _type.BindType;
+	export const PrimitiveType = _type.PrimitiveType;
 	export const External = _external.External;
 }
 
@@ -41,8 +42,13 @@ export namespace _nbind {
 	): number[] | Uint8Array | Buffer {
 		if(buf instanceof ArrayBuffer) {
 			return(new Uint8Array(buf));
-		} else if(buf instanceof DataView) {
-			return(new Uint8Array(buf.buffer, buf.byteOffset, buf.byteLength));
+		} else if(
+			buf instanceof DataView ||
+			(ArrayBuffer.isView(buf) && !(buf instanceof Uint8Array))
+		) {
+			// Access other typed arrays byte by byte.
+			const view = buf as DataView;
+			return(new Uint8Array(view.buffer, view.byteOffset, view.byteLength));
 		} else return(buf);
 	}
 
@@ -73,18 +79,129 @@ export namespace _nbind {
 		return(result);
 	}
 
+	/** Copy a returned buffer off the heap. */
+
+	function popBuffer(ptr: number) {
+		if(ptr === 0) return(null);
+
+		const length = HEAPU32[ptr / 4];
+		const data = HEAPU32[ptr / 4 + 1];
+
+		return(new Uint8Array(HEAPU8.subarray(data, data + length)));
+	}
+
 	export class BufferType extends BindType {
 		makeWireWrite(expr: string, policyTbl: PolicyTbl) {
 			return((arg: any) => pushBuffer(arg, policyTbl));
 		}
 
+		wireRead = popBuffer;
 		wireWrite = pushBuffer;
 
 		readResources = [ resources.pool ];
 		writeResources = [ resources.pool ];
 	}
 
-	// Called from EM_ASM block in Buffer.h
+	/** Get the typed array class matching C++ span members. */
+
+	function getSpanClass(type: SpanType): any {
+		const memberType = type.memberType;
+
+		if(memberType instanceof PrimitiveType && memberType.heap) {
+			return(memberType.heap.constructor);
+		}
+
+		return(Uint8Array);
+	}
+
+	function pushSpan(
+		buf: ArrayBuffer | ArrayBufferView,
+		type: SpanType,
+		policyTbl?: PolicyTbl
+	) {
+		const result = Pool.lalloc(12);
+		let ptr = result / 4;
+
+		if(buf === null || buf === undefined) {
+			if(!policyTbl || !policyTbl['Nullable']) throw(new Error('Type mismatch'));
+
+			HEAPU32[ptr++] = 0;
+			HEAPU32[ptr++] = 0;
+			HEAPU32[ptr++] = 0;
+
+			return(result);
+		}
+
+		const size = type.memberType.ptrSize;
+		const Class = getSpanClass(type);
+		let view: Uint8Array;
+
+		if(buf instanceof Class) {
+			const arr = buf as ArrayBufferView;
+			view = new Uint8Array(arr.buffer, arr.byteOffset, arr.byteLength);
+		} else if(buf instanceof ArrayBuffer && buf.byteLength % size == 0) {
+			view = new Uint8Array(buf);
+		} else throw(new Error('Type mismatch'));
+
+		const length = view.byteLength;
+
+		HEAPU32[ptr++] = length / size;
+
+		if(view.buffer == HEAPU8.buffer && view.byteOffset % size == 0) {
+			// The view is already on the heap, so C++ can use it directly.
+			HEAPU32[ptr++] = view.byteOffset;
+			HEAPU32[ptr++] = 0;
+		} else {
+			const data = _malloc(length);
+
+			HEAPU32[ptr++] = data;
+			HEAPU32[ptr++] = new ExternalBuffer(buf, data).register();
+
+			HEAPU8.set(view, data);
+		}
+
+		return(result);
+	}
+
+	/** Make a typed array aliasing C++ memory on the heap.
+	  * It becomes invalid if the heap grows. */
+
+	function popSpan(ptr: number, type: SpanType) {
+		const length = HEAPU32[ptr / 4];
+		const data = HEAPU32[ptr / 4 + 1];
+
+		if(!data) return(null);
+
+		const Class = getSpanClass(type);
+
+		return(new Class(
+			HEAPU8.buffer,
+			data,
+			Class == Uint8Array ? length * type.memberType.ptrSize : length
+		));
+	}
+
+	export class SpanType extends BindType {
+		constructor(spec: TypeSpecWithParam) {
+			super(spec);
+
+			this.memberType = spec.paramList[0] as _type.BindType;
+		}
+
+		makeWireWrite(expr: string, policyTbl: PolicyTbl) {
+			return((arg: any) => pushSpan(arg, this, policyTbl));
+		}
+
+		wireRead = (arg: number) => popSpan(arg, this);
+		wireWrite = (arg: any) => pushSpan(arg, this);
+
+		readResources = [ resources.pool ];
+		writeResources = [ resources.pool ];
+
+		memberType: _type.BindType;
+	}
+
+	// Called from EM_ASM block in Buffer.h and Span.h
 
 	export function commitBuffer(num: number, data: number, length: number) {
 		const buf = (_nbind.externalList[num] as ExternalBuffer).data;
@@ -12,6 +12,7 @@ import { _nbind as _wrapper } from './Wrapper';
 import { _nbind as _external } from './External';
 import { _nbind as _resource } from './Resource';
 import { TypeFlags, PolicyTbl } from '../Type';
+import { SignatureType } from '../common';
 
 // Let decorators run eval in current scope to read function source code.
 setEvil((code: string) => eval(code));
@@ -19,10 +20,17 @@ setEvil((code: string) => eval(code));
 export namespace _nbind {
 
 	type BindType = _type.BindType;
+	export const PrimitiveType = _type.PrimitiveType;
 
 	type Wrapper = _wrapper.Wrapper;
 
 	type Func = _globals.Func;
+
+	// Not in the ES5 typings, but available where Async functions are used.
+	declare const Promise: any;
+
+	declare const performance: any;
+	declare const process: any;
 	type FuncList = _globals.FuncList;
 	type TypeIdList = _globals.TypeIdList;
 
@@ -36,6 +44,109 @@ export namespace _nbind {
 	export let listResources: typeof _resource.listResources;
 	export let resources: typeof _resource.resources;
 
+	/** Call counters and times in nanoseconds for a bound function,
+	  * kept when compiled with NBIND_PROFILE. */
+
+	export class ProfileEntry {
+		constructor(public name: string) {
+			for(let num = 0; num < 32; ++num) this.histogram[num] = 0;
+		}
+
+		/** Current time in nanoseconds. */
+
+		now() {
+			if(typeof(performance) == 'object' && performance.now) {
+				return(performance.now() * 1e6);
+			} else if(typeof(process) == 'object' && process.hrtime) {
+				const time = process.hrtime();
+				return(time[0] * 1e9 + time[1]);
+			}
+
+			return(Date.now() * 1e6);
+		}
+
+		/** Record a call started at time t0. Arguments were converted at t1
+		  * and the C++ function returned at t2, or zero if not reached. */
+
+		add(t0: number, t1: number, t2: number, ok: boolean) {
+			const end = this.now();
+			let total = end - t0;
+
+			if(!t1) t1 = end;
+			if(!t2) t2 = end;
+
+			++this.calls;
+			if(!ok) ++this.exceptions;
+
+			this.time += total;
+			this.argTime += t1 - t0;
+			this.bodyTime += t2 - t1;
+			this.returnTime += end - t2;
+
+			// Find the histogram bucket.
+
+			let bucket = 0;
+
+			while(total >= 2 && bucket < 31) {
+				total /= 2;
+				++bucket;
+			}
+
+			++this.histogram[bucket];
+		}
+
+		calls = 0;
+		exceptions = 0;
+		time = 0;
+		argTime = 0;
+		bodyTime = 0;
+		returnTime = 0;
+
+		/** Bucket n counts calls taking from 2^n to 2^(n+1) nanoseconds.
+		  * The last one also counts any slower calls. */
+		histogram: number[] = [];
+	}
+
+	/** Profiled functions, if compiled with NBIND_PROFILE. Otherwise null. */
+
+	export let profileList: ProfileEntry[] | null = null;
+
+	/** Make a profile entry for a function or method, if profiling.
+	  * Constructors and destructors are not profiled. */
+
+	function makeProfileEntry(spec: _class.MethodSpec) {
+		const type = spec.signatureType;
+
+		if(!profileList || !(
+			type == SignatureType.func ||
+			type == SignatureType.method ||
+			type == SignatureType.getter ||
+			type == SignatureType.setter
+		)) return(null);
+
+		const profile = new ProfileEntry(spec.title);
+		profileList.push(profile);
+
+		return(profile);
+	}
+
+	/** Report calls to profiled functions called at least once. */
+
+	export function getCallStats() {
+		return((profileList || []).filter(
+			(profile: ProfileEntry) => profile.calls > 0
+		).map((profile: ProfileEntry) => ({
+			name: profile.name,
+			calls: profile.calls,
+			exceptions: profile.exceptions,
+			time: profile.time,
+			argTime: profile.argTime,
+			bodyTime: profile.bodyTime,
+			returnTime: profile.returnTime,
+			histogram: profile.histogram.slice(0)
+		})));
+	}
+
 	/** Make a list of argument names a1, a2, a3...
 	  * for dynamically generating function source code. */
 
@@ -79,7 +190,7 @@ export namespace _nbind {
 		const paramNum = convertParamList.length;
 
 		if(type.makeWireRead) {
-			return(type.makeWireRead(expr, convertParamList, paramNum));
+			return(type.makeWireRead(expr, policyTbl, convertParamList, paramNum));
 		} else if(type.wireRead) {
 			convertParamList[paramNum] = type.wireRead;
 			return('(convertParamList[' + paramNum + '](' + expr + '))');
@@ -127,13 +238,21 @@ export namespace _nbind {
 		returnType: BindType,
 		argTypeList: BindType[],
 		mask?: number,
-		err?: () => void
+		err?: () => void,
+		profile?: ProfileEntry | null
 	) {
 		const argList = makeArgList(argTypeList.length);
 		/** List of arbitrary data for type converters.
 		  * Each one may read and write its own slot. */
 		const convertParamList: any[] = [];
 
+		if(profile) {
+			return(buildProfiledCallerFunction(
+				dynCall, ptrType, ptr, num, policyTbl, prefix,
+				returnType, argTypeList, mask, err, profile
+			));
+		}
+
 		// Build code for function call and type conversion.
 
 		const callExpression = makeWireRead(
@@ -173,6 +292,63 @@ export namespace _nbind {
 		return(eval('(' + sourceCode + ')') as (...args: any[]) => any);
 	}
 
+	/** Like buildCallerFunction, but timing argument conversion,
+	  * the C++ call and return value conversion separately. */
+
+	function buildProfiledCallerFunction(
+		dynCall: Func,
+		ptrType: _class.BindClassPtr | null,
+		ptr: number,
+		num: number,
+		policyTbl: PolicyTbl | null,
+		prefix: string,
+		returnType: BindType,
+		argTypeList: BindType[],
+		mask: number | undefined,
+		err: (() => void) | undefined,
+		profile: ProfileEntry
+	) {
+		const argList = makeArgList(argTypeList.length);
+		const convertParamList: any[] = [];
+
+		const wireList = argList.map(
+			(name: string, index: number) => makeWireWrite(
+				convertParamList,
+				policyTbl,
+				argTypeList[index],
+				name
+			)
+		);
+
+		const callArgs = [prefix].concat(argList.map((name: string) => 'w' + name));
+		const readExpression = makeWireRead(convertParamList, policyTbl, returnType, 'v');
+		const resourceSet = listResources([returnType], argTypeList);
+
+		const sourceCode = (
+			'function(' + argList.join(',') + '){' +
+				(mask ? 'this.__nbindFlags&mask&&err();' : '') +
+				'var t0=profile.now(),t1=0,t2=0,ok=false;' +
+				'try{' +
+					resourceSet.makeOpen() +
+					argList.map(
+						(name: string, index: number) => 'var w' + name + '=' + wireList[index] + ';'
+					).join('') +
+					't1=profile.now();' +
+					'var v=dynCall(' + callArgs.join(',') + ');' +
+					't2=profile.now();' +
+					'var r=' + readExpression + ';' +
+					resourceSet.makeClose() +
+					'ok=true;' +
+					'return r;' +
+				'}finally{' +
+					'profile.add(t0,t1,t2,ok);' +
+				'}' +
+			'}'
+		);
+
+		return(eval('(' + sourceCode + ')') as (...args: any[]) => any);
+	}
+
 	/** Dynamically build a function that calls a JavaScript callback invoker
 	  * with appropriate type conversion for complicated types:
 		* - Read arguments from stack.
@@ -292,7 +468,9 @@ export namespace _nbind {
 			throw(new Error('Calling a non-const method on a const object'));
 		}
 
-		if(!needsWireRead && !needsWireWrite) {
+		const profile = makeProfileEntry(spec);
+
+		if(!needsWireRead && !needsWireWrite && !profile) {
 			// If there are only a few arguments not requiring type conversion,
 			// build a simple invoker function without using eval.
 
@@ -327,7 +505,8 @@ export namespace _nbind {
 			returnType,
 			argTypeList,
 			mask,
-			err
+			err,
+			profile
 		));
 	}
 
@@ -344,6 +523,7 @@ export namespace _nbind {
 		const direct = spec.direct!;
 		let dynCall: (...args: any[]) => any;
 		let ptr = spec.ptr;
+		const profile = makeProfileEntry(spec);
 
 		if(spec.direct && !needsWireRead && !needsWireWrite) {
 			// If there are only a few arguments not requiring type conversion,
@@ -351,7 +531,7 @@ export namespace _nbind {
 
 			dynCall = getDynCall(typeList, spec.title);
 
-			switch(argCount) {
+			switch(profile ? -1 : argCount) {
 				case 0: return(() =>
 				        dynCall(direct));
 				case 1: return((        a1: any) =>
@@ -398,7 +578,10 @@ export namespace _nbind {
 			needsWireWrite,
 			prefix,
 			returnType,
-			argTypeList
+			argTypeList,
+			0,
+			undefined,
+			profile
 		));
 	}
 
@@ -423,6 +606,68 @@ export namespace _nbind {
 		return(call);
 	}
 
+	/** Wrap a function with the Async policy to return a Promise.
+	  * Web workers cannot share the asm.js heap, so it runs immediately. */
+
+	export function makeAsync(func: Func) {
+		return(function(this: any) {
+			const args = arguments;
+
+			return(new Promise((resolve: (result: any) => void, reject: (err: any) => void) => {
+				try {
+					resolve(func.apply(this, args));
+				} catch(err) {
+					reject(err);
+				}
+			}));
+		});
+	}
+
+	/** Create a batch caller calling func once for each row in columns
+	  * of arguments, passed as arrays or typed arrays of equal length.
+	  * Methods take the target object as the first argument.
+	  * Numeric results are returned in a typed array. */
+
+	export function makeBatch(func: Func, spec: _class.MethodSpec, isMethod: boolean) {
+		const arity = spec.typeList!.length - 1;
+		const first = isMethod ? 1 : 0;
+		const returnType = getTypes([ spec.typeList![0] ], spec.title)[0];
+		let Result: any = Array;
+
+		if(returnType instanceof PrimitiveType && returnType.heap && !(spec.policyTbl && spec.policyTbl['Async'])) {
+			Result = returnType.heap.constructor;
+		}
+
+		return(function batch(this: any) {
+			if(!arity) throw(new Error('Batch call needs argument columns'));
+
+			if(arguments.length != first + arity) {
+				throw(new Error('Wrong number of arguments, expected ' + (first + arity)));
+			}
+
+			const target = isMethod ? arguments[0] : this;
+			const columnList: any[] = Array.prototype.slice.call(arguments, first);
+			const length = columnList[0].length;
+
+			for(let column of columnList) {
+				if(column === null || typeof(column) != 'object' || column.length !== length) {
+					throw(new Error('Batch argument columns differ in length'));
+				}
+			}
+
+			const result: any[] = new Result(length);
+			const args: any[] = new Array(arity);
+
+			for(let row = 0; row < length; ++row) {
+				for(let num = 0; num < arity; ++num) args[num] = columnList[num][row];
+
+				result[row] = func.apply(target, args);
+			}
+
+			return(result);
+		});
+	}
+
 	@prepareNamespace('_nbind')
 	export class _ {} // tslint:disable-line:class-name
 }
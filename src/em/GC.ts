@@ -46,6 +46,79 @@ export namespace _nbind {
 		}
 	}
 
+	/** Wrappers constructed from JavaScript in each open arena scope,
+	  * innermost last. */
+	const arenaStack: Wrapper[][] = [];
+
+	export function trackArena(obj: Wrapper) {
+		if(arenaStack.length) arenaStack[arenaStack.length - 1].push(obj);
+	}
+
+	/** Run scope, destroying objects of arena allocated classes
+	  * constructed inside it when it returns or throws. */
+
+	export function withArena<Result>(scope: () => Result): Result {
+		const list: Wrapper[] = [];
+
+		arenaStack.push(list);
+		Module['NBind'].enterArena();
+
+		try {
+			return(scope());
+		} finally {
+			arenaStack.pop();
+
+			// Free only the wrappers, the arena frees the objects.
+
+			for(let obj of list) {
+				if(
+					!(obj.__nbindState & StateFlags.isDeleted) &&
+					Module['NBind'].arenaOwns(obj.__nbindPtr)
+				) {
+					obj.free!();
+				}
+			}
+
+			Module['NBind'].leaveArena();
+		}
+	}
+
+	/** Wrappers owning their C++ object, constructed inside
+	  * each open scope, innermost last. */
+	const scopeStack: Wrapper[][] = [];
+
+	export function trackScope(obj: Wrapper) {
+		if(scopeStack.length && obj.__nbindShared) scopeStack[scopeStack.length - 1].push(obj);
+	}
+
+	/** Run fn, freeing objects constructed inside it when it returns or throws,
+	  * except persistent ones and the return value. */
+
+	export function scope<Result>(fn: () => Result): Result {
+		const list: Wrapper[] = [];
+		let result: Result | undefined;
+
+		scopeStack.push(list);
+
+		try {
+			result = fn();
+			return(result);
+		} finally {
+			scopeStack.pop();
+
+			const parent = scopeStack[scopeStack.length - 1];
+
+			for(let obj of list) {
+				if(obj.__nbindState & (StateFlags.isPersistent | StateFlags.isDeleted)) continue;
+
+				if(obj === result as any) {
+					// The returned object now belongs to the surrounding scope, if any.
+					if(parent) parent.push(obj);
+				} else obj.free!();
+			}
+		}
+	}
+
 	@prepareNamespace('_nbind')
 	export class _ {} // tslint:disable-line:class-name
 }
@@ -23,6 +23,112 @@ export namespace _nbind {
 
 	export let mark: typeof _gc.mark;
 
+	export let trackArena: typeof _gc.trackArena;
+
+	export let trackScope: typeof _gc.trackScope;
+
+	/** Construction site of sampled wrappers, by JavaScript stack trace. */
+
+	export interface AllocationSite {
+		stack: string;
+		live: number;
+		total: number;
+	}
+
+	/** Counts of live wrappers of a single class. */
+
+	export class LiveStats {
+		constructor(public bindClass: _class.BindClass) {}
+
+		/** Count a new wrapper. If sampled, return its construction site. */
+
+		add(flags: TypeFlags, shared?: number) {
+			++this.live;
+
+			if(shared) {
+				++this.shared;
+				this.bytes += this.bindClass.size;
+			} else ++this.raw;
+
+			if(flags & TypeFlags.isConst) ++this.constant;
+
+			if(!sampleInterval || --sampleCountdown) return(null);
+
+			sampleCountdown = sampleInterval;
+
+			const stack = new Error().stack || '';
+			let site = this.siteTbl[stack];
+
+			if(!site) {
+				site = { stack: stack, live: 0, total: 0 };
+				this.siteTbl[stack] = site;
+			}
+
+			++site.live;
+			++site.total;
+
+			return(site);
+		}
+
+		remove(flags: TypeFlags, shared?: number, site?: AllocationSite) {
+			--this.live;
+
+			if(shared) {
+				--this.shared;
+				this.bytes -= this.bindClass.size;
+			} else --this.raw;
+
+			if(flags & TypeFlags.isConst) --this.constant;
+
+			if(site) --site.live;
+		}
+
+		live = 0;
+		shared = 0;
+		raw = 0;
+		constant = 0;
+		/** Estimated from the size of C++ objects owned through shared pointers. */
+		bytes = 0;
+
+		siteTbl: { [stack: string]: AllocationSite } = {};
+	}
+
+	const liveStatsList: LiveStats[] = [];
+
+	/** Sample one in every sampleInterval wrappers constructed, or none if zero. */
+	let sampleInterval = 0;
+	let sampleCountdown = 0;
+
+	/** Record JavaScript stack traces for a fraction of wrappers constructed,
+	  * or none if zero. */
+
+	export function sampleAllocations(rate: number) {
+		sampleInterval = rate > 0 ? Math.max(1, Math.round(1 / rate)) : 0;
+		sampleCountdown = sampleInterval;
+	}
+
+	/** Report classes with live wrappers. */
+
+	export function getLiveObjects() {
+		return(liveStatsList.filter(
+			(stats: LiveStats) => stats.live > 0
+		).map((stats: LiveStats) => ({
+			name: stats.bindClass.name,
+			live: stats.live,
+			shared: stats.shared,
+			raw: stats.raw,
+			constant: stats.constant,
+			bytes: stats.bytes,
+			sites: Object.keys(stats.siteTbl).map(
+				(stack: string) => stats.siteTbl[stack]
+			).filter(
+				(site: AllocationSite) => site.live > 0
+			).map(
+				(site: AllocationSite) => ({ stack: site.stack, live: site.live, total: site.total })
+			)
+		})));
+	}
+
 	/** Base class for wrapped instances of bound C++ classes.
 	  * Note that some hacks avoid ever constructing this,
 	  * so initializing values inside its definition won't work. */
@@ -37,6 +143,9 @@ export namespace _nbind {
 		__nbindFlags: TypeFlags;
 		__nbindState: StateFlags;
 
+		/** Construction site if sampled by sampleAllocations. */
+		__nbindSite?: AllocationSite;
+
 		/** Dynamically set by _nbind_register_constructor.
 		  * Calls the C++ constructor and returns a numeric heap pointer. */
 		__nbindConstructor: (...args: any[]) => number;
@@ -53,6 +162,10 @@ export namespace _nbind {
 		policyTbl: PolicyTbl,
 		bindClass: _class.BindClass
 	) {
+		const liveStats = new LiveStats(bindClass);
+
+		liveStatsList.push(liveStats);
+
 		class Bound extends Wrapper {
 			constructor(marker: {}, flags: number, ptr: number, shared?: number) {
 				super();
@@ -81,6 +194,8 @@ export namespace _nbind {
 					nbindFlags = TypeFlags.isSharedClassPtr | TypeFlags.isSharedPtr;
 					nbindShared = HEAPU32[wirePtr / 4];
 					nbindPtr = HEAPU32[wirePtr / 4 + 1];
+
+					trackArena(this);
 				}
 
 				const spec = {
@@ -100,17 +215,25 @@ export namespace _nbind {
 					mark(this);
 				}
 
+				const site = liveStats.add(nbindFlags, nbindShared);
+
+				if(site) propTbl['__nbindSite'] = site;
+
 				for(let key of Object.keys(propTbl)) {
 					spec.value = propTbl[key];
 					Object.defineProperty(this, key, spec);
 				}
 
 				_defineHidden(StateFlags.none)(this, '__nbindState');
+
+				trackScope(this);
 			}
 
 			free() {
 				bindClass.destroy.call(this, this.__nbindShared, this.__nbindFlags);
 
+				liveStats.remove(this.__nbindFlags, this.__nbindShared, this.__nbindSite);
+
 				this.__nbindState |= StateFlags.isDeleted;
 
 				disableMember(this, '__nbindShared');
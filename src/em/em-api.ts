@@ -69,10 +69,18 @@ export namespace _nbind {
 	export let StringType: typeof _std.StringType;
 
 	export let makeMethodCaller: typeof _caller.makeMethodCaller;
+	export let profileList: typeof _caller.profileList;
+	export let getCallStats: typeof _caller.getCallStats;
 
 	export let BufferType: typeof _buffer.BufferType;
+	export let SpanType: typeof _buffer.SpanType;
+
+	export let getLiveObjects: typeof _wrapper.getLiveObjects;
+	export let sampleAllocations: typeof _wrapper.sampleAllocations;
 
 	export let toggleLightGC: typeof _gc.toggleLightGC;
+	export let withArena: typeof _gc.withArena;
+	export let scope: typeof _gc.scope;
 }
 
 publishNamespace('_nbind');
@@ -109,6 +117,7 @@ class nbind { // tslint:disable-line:class-name
 			[TypeFlags.isArray]: _nbind.ArrayType,
 			[TypeFlags.isCString]: _nbind.CStringType,
 			[TypeFlags.isCallback]: _nbind.CallbackType,
+			[TypeFlags.isSpan]: _nbind.SpanType,
 			[TypeFlags.isOther]: _nbind.BindType
 		};
 
@@ -122,10 +131,15 @@ class nbind { // tslint:disable-line:class-name
 			'cbFunction &': _nbind.CallbackType,
 			'const cbFunction &': _nbind.CallbackType,
 			'const std::string &': _nbind.StringType,
-			'std::string': _nbind.StringType
+			'std::string': _nbind.StringType,
+			'std::string_view': _nbind.StringType
 		};
 
 		Module['toggleLightGC'] = _nbind.toggleLightGC;
+		Module['withArena'] = _nbind.withArena;
+		Module['scope'] = _nbind.scope;
+		Module['liveObjects'] = _nbind.getLiveObjects;
+		Module['sampleAllocations'] = _nbind.sampleAllocations;
 		_nbind.callUpcast = Module['dynCall_ii'];
 
 		const globalScope = _nbind.makeType(_nbind.constructType, {
@@ -170,7 +184,8 @@ class nbind { // tslint:disable-line:class-name
 		upcastListPtr: number,
 		superCount: number,
 		destructorPtr: number,
-		namePtr: number
+		namePtr: number,
+		size: number
 	) {
 		const name = _nbind.readAsciiString(namePtr);
 		const policyTbl = _nbind.readPolicyList(policyListPtr);
@@ -210,6 +225,8 @@ class nbind { // tslint:disable-line:class-name
 			);
 		}
 
+		bindClass.size = size;
+
 		Module[bindClass.name] = bindClass.makeBound(policyTbl);
 
 		_nbind.BindClass.list.push(bindClass);
@@ -276,6 +293,12 @@ class nbind { // tslint:disable-line:class-name
 		}
 	}
 
+	@dep('_nbind')
+	static _nbind_enable_profile() {
+		_nbind.profileList = [];
+		Module['callStats'] = _nbind.getCallStats;
+	}
+
 	@dep('_nbind')
 	static _nbind_finish() {
 		for(let bindClass of _nbind.BindClass.list) bindClass.finish();
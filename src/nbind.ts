@@ -67,6 +67,69 @@ export interface DefaultExportType {
 	};
 }
 
+/** Usage of cached strings returned with StaticString and Interned policies. */
+
+export interface StringCacheStats {
+	hits: number;
+	misses: number;
+	size: number;
+}
+
+/** Size and probe counts of the table mapping C++ pointers to wrapper objects. */
+
+export interface WrapperTableStats {
+	size: number;
+	capacity: number;
+	lookups: number;
+	probes: number;
+	longestProbe: number;
+}
+
+/** Numbers of classes with an instantiated JavaScript constructor,
+  * and all bound classes. */
+
+export interface ClassStats {
+	ready: number;
+	total: number;
+}
+
+/** Calls to a bound function, with times in nanoseconds spent converting
+  * arguments, in the C++ function and converting the return value. */
+
+export interface CallStats {
+	name: string;
+	calls: number;
+	exceptions: number;
+	time: number;
+	argTime: number;
+	bodyTime: number;
+	returnTime: number;
+	/** Item n counts calls taking from 2^n to 2^(n+1) nanoseconds. */
+	histogram: number[];
+}
+
+/** JavaScript stack trace where sampled wrapper objects were constructed. */
+
+export interface AllocationSite {
+	stack: string;
+	live: number;
+	total: number;
+}
+
+/** Counts of live wrapper objects of a class, and estimated bytes of memory
+  * in C++ objects owned through shared pointers. */
+
+export interface LiveObjects {
+	name: string;
+	live: number;
+	shared: number;
+	raw: number;
+	constant: number;
+	bytes: number;
+	/** Sampled construction sites with live objects. */
+	sites: AllocationSite[];
+}
+
 export class Binding<ExportType extends DefaultExportType> {
 	[ key: string ]: any;
 
@@ -101,6 +164,32 @@ export class Binding<ExportType extends DefaultExportType> {
 
 	toggleLightGC: (enable: boolean) => void;
 
+	/** Run scope, destroying objects of arena allocated classes
+	  * constructed inside it when it returns or throws. */
+	withArena: <Result>(scope: () => Result) => Result;
+
+	/** Run fn, freeing objects owned by JavaScript and constructed inside it
+	  * when it returns or throws, except persistent ones and the return value. */
+	scope: <Result>(fn: () => Result) => Result;
+
+	/** Get string cache statistics (only available in Node.js addons). */
+	stringCacheStats?: () => StringCacheStats;
+
+	/** Get wrapper table statistics (only available in Node.js addons). */
+	wrapperTableStats?: () => WrapperTableStats;
+
+	/** Get counts of classes set up so far (only available in Node.js addons). */
+	classStats?: () => ClassStats;
+
+	/** Get profiled calls (only available when compiled with NBIND_PROFILE). */
+	stats?: () => CallStats[];
+
+	/** Get counts of live wrapper objects for each class with any. */
+	liveObjects: () => LiveObjects[];
+
+	/** Record construction sites of a fraction of wrapper objects, or none if zero. */
+	sampleAllocations: (rate: number) => void;
+
 	binary: ModuleSpec;
 	/** Exported API of a C++ library compiled for nbind. */
 	lib: ExportType;
@@ -325,8 +414,120 @@ function initNode<ExportType extends DefaultExportType>(
 	binding.queryType = lib.NBind.queryType;
 	binding.toggleLightGC = function(enable: boolean) {}; // tslint:disable-line:no-empty
 
+	binding.withArena = function<Result>(scope: () => Result) {
+		lib.NBind.enterArena();
+
+		try {
+			return(scope());
+		} finally {
+			lib.NBind.leaveArena();
+		}
+	};
+
+	binding.scope = function<Result>(fn: () => Result) {
+		let result: Result | undefined;
+
+		lib.NBind.enterScope();
+
+		try {
+			result = fn();
+			return(result);
+		} finally {
+			lib.NBind.leaveScope(result);
+		}
+	};
+
+	binding.stringCacheStats = function() {
+		let result: StringCacheStats | undefined;
+
+		lib.NBind.getStringCacheStats((hits: number, misses: number, size: number) => {
+			result = { hits, misses, size };
+		});
+
+		return(result!);
+	};
+
+	binding.wrapperTableStats = function() {
+		let result: WrapperTableStats | undefined;
+
+		lib.NBind.getWrapperTableStats((
+			size: number,
+			capacity: number,
+			lookups: number,
+			probes: number,
+			longestProbe: number
+		) => {
+			result = { size, capacity, lookups, probes, longestProbe };
+		});
+
+		return(result!);
+	};
+
+	binding.classStats = function() {
+		let result: ClassStats | undefined;
+
+		lib.NBind.getClassStats((ready: number, total: number) => {
+			result = { ready, total };
+		});
+
+		return(result!);
+	};
+
+	binding.liveObjects = function() {
+		const result: LiveObjects[] = [];
+		const classTbl: { [name: string]: LiveObjects } = {};
+
+		lib.NBind.getLiveObjects((
+			name: string,
+			live: number,
+			shared: number,
+			raw: number,
+			constant: number,
+			bytes: number
+		) => {
+			const stats = { name, live, shared, raw, constant, bytes, sites: [] as AllocationSite[] };
+
+			classTbl[name] = stats;
+			result.push(stats);
+		}, (name: string, stack: string, live: number, total: number) => {
+			if(classTbl[name]) classTbl[name].sites.push({ stack, live, total });
+		});
+
+		return(result);
+	};
+
+	binding.sampleAllocations = function(rate: number) {
+		lib.NBind.setAllocationSampling(rate > 0 ? Math.max(1, Math.round(1 / rate)) : 0);
+	};
+
+	if(lib.NBind.getCallStats) {
+		binding.stats = function() {
+			const result: CallStats[] = [];
+
+			lib.NBind.getCallStats((
+				name: string,
+				calls: number,
+				exceptions: number,
+				time: number,
+				argTime: number,
+				bodyTime: number,
+				returnTime: number,
+				histogram: number[]
+			) => {
+				result.push({ name, calls, exceptions, time, argTime, bodyTime, returnTime, histogram });
+			});
+
+			return(result);
+		};
+	}
+
 	Object.keys(lib).forEach(function(key: string) {
-		binding.lib[key] = lib[key];
+		const desc = Object.getOwnPropertyDescriptor(lib, key);
+
+		// Copy getters of lazily registered classes without calling them.
+
+		if(desc && desc.get) Object.defineProperty(binding.lib, key, desc);
+		else binding.lib[key] = lib[key];
 	});
 
 	callback(null, binding);
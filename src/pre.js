@@ -40,6 +40,11 @@
 				reflect: Module.NBind.reflect,
 				queryType: Module.NBind.queryType,
 				toggleLightGC: Module.toggleLightGC,
+				withArena: Module.withArena,
+				scope: Module.scope,
+				stats: Module.callStats,
+				liveObjects: Module.liveObjects,
+				sampleAllocations: Module.sampleAllocations,
 				lib: Module
 			});
 		});
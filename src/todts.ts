@@ -14,11 +14,30 @@ const nameTbl: { [key: string]: [string, boolean] } = {
 	'bool': ['boolean', false],
 	'cbFunction &': ['(...args: any[]) => any', true],
 	'std::string': ['string', false],
+	'std::string_view': ['string', false],
 	'void': ['void', false]
 };
 
 type PolicyTbl = { [key: string]: boolean };
 
+/** Get name of typed array class matching a numeric type, if any. */
+
+function getTypedArrayName(bindType: BindType) {
+	const flags = bindType.flags;
+	const bits = (bindType.spec.ptrSize || 0) * 8;
+
+	if((flags & TypeFlags.kindMask) != TypeFlags.isArithmetic) return(null);
+	if(flags & TypeFlags.isSignless || bits > 64) return(null);
+
+	if(flags & TypeFlags.isFloat) {
+		return(bits == 32 || bits == 64 ? 'Float' + bits + 'Array' : null);
+	}
+
+	if(bits > 32) return(null);
+
+	return((flags & TypeFlags.isUnsigned ? 'Uint' : 'Int') + bits + 'Array');
+}
+
 // tslint:disable-next-line:typedef
 function formatType(bindType: BindType, policyTbl: PolicyTbl = {}, needParens = false): string {
 	const flags = bindType.flags;
@@ -62,8 +81,29 @@ function formatType(bindType: BindType, policyTbl: PolicyTbl = {}, needParens =
 
 		case TypeFlags.isVector:
 		case TypeFlags.isArray:
+			const typedName = getTypedArrayName(bindType.spec.paramList![0] as BindType);
+
+			// Numeric arrays may be passed as typed arrays,
+			// and the TypedArray policy returns them as such.
+
+			if(typedName == 'Uint8Array' && policyTbl['Return'] && policyTbl['Bytes']) {
+				return('Uint8Array');
+			} else if(typedName && policyTbl['Return']) {
+				if(policyTbl['TypedArray']) return(typedName);
+			} else if(typedName) {
+				return(addParens(formatSubType(true) + '[] | ' + typedName));
+			}
+
 			return(addParens(formatSubType(true) + '[]'));
 
+		case TypeFlags.isSpan:
+			const spanName = getTypedArrayName(bindType.spec.paramList![0] as BindType);
+
+			if(!spanName) return('ArrayBuffer');
+			if(policyTbl['Return']) return(spanName);
+
+			return(addParens(spanName + ' | ArrayBuffer'));
+
 		case TypeFlags.isCString:
 			return(isNullable ? addParens('string | null') : 'string');
 
@@ -80,6 +120,11 @@ function formatType(bindType: BindType, policyTbl: PolicyTbl = {}, needParens =
 			));
 
 		case TypeFlags.isOther:
+			if(policyTbl['Return'] && (
+				bindType.name == 'Buffer' ||
+				(bindType.name == 'std::string' && policyTbl['Bytes'])
+			)) return('Uint8Array');
+
 			const spec = nameTbl[bindType.name];
 			return(spec ? (spec[1] ? addParens(spec[0]) : spec[0]) : 'any');
 
@@ -101,7 +146,19 @@ function formatMethod(method: BindMethod) {
 
 	if(method.name) {
 		// Most return types may be null.
-		return(method.name + args + ': ' + formatType(method.returnType, { 'Nullable': true }) + ';');
+		let returnType = formatType(
+			method.returnType,
+			{
+				'Bytes': policyTbl['Bytes'],
+				'Nullable': true,
+				'Return': true,
+				'TypedArray': policyTbl['TypedArray']
+			}
+		);
+
+		if(policyTbl['Async']) returnType = 'Promise<' + returnType + '>';
+
+		return(method.name + args + ': ' + returnType + ';');
 	} else {
 		return('constructor' + args + ';');
 	}
@@ -122,7 +179,7 @@ export function dump(options: { reflect: Reflect, shim?: boolean } ) {
 		classCodeList.push('import { Buffer } from "nbind/dist/shim";');
 	}
 
-	classCodeList.push('export class NBindBase { free?(): void }');
+	classCodeList.push('export class NBindBase { free?(): void; persist?(): void }');
 
 	if(options.reflect.globalScope) {
 		classList = classList.concat([options.reflect.globalScope]);
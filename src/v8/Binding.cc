@@ -4,8 +4,14 @@
 #ifdef BUILDING_NODE_EXTENSION
 
 #include <cstring>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <unordered_set>
 
+#include <v8-profiler.h>
+
 #include "nbind/BindDefiner.h"
 
 using namespace v8;
@@ -95,8 +101,159 @@ const char *NBindID :: toString() {
 	return(name);
 }
 
+void NBind :: getStringCacheStats(cbFunction &outStats) {
+	StringCache::Stats stats = StringCache::getStats();
+	unsigned int size = StringCache::size();
+
+	outStats(stats.hits, stats.misses, size);
+}
+
+void NBind :: getWrapperTableStats(cbFunction &outStats) {
+#	if !defined(NBIND_DUPLICATE_POINTERS)
+		InstanceTable &tbl = BindWrapperBase::getInstanceTbl();
+		InstanceTable::Stats stats = tbl.getStats();
+
+		outStats(
+			static_cast<double>(tbl.size()),
+			static_cast<double>(tbl.capacity()),
+			stats.lookups,
+			stats.probes,
+			stats.longestProbe
+		);
+#	else
+		outStats(0, 0, 0, 0, 0);
+#	endif // NBIND_DUPLICATE_POINTERS
+}
+
+void NBind :: getLiveObjects(cbFunction &outClass, cbFunction &outSite) {
+	for(auto *bindClass : getClassList()) {
+		const LiveStats &stats = bindClass->getState().liveStats;
+
+		if(stats.live == 0) continue;
+
+		outClass(
+			bindClass->getName(),
+			stats.live,
+			stats.shared,
+			stats.raw,
+			stats.constant,
+			stats.bytes
+		);
+	}
+
+	for(auto &site : AllocationSampler::getSiteList()) {
+		if(site.live == 0) continue;
+
+		outSite(site.className, site.stack, site.live, site.total);
+	}
+}
+
+void NBind :: setAllocationSampling(unsigned int interval) {
+	AllocationSampler::setInterval(interval);
+}
+
+void NBind :: enterArena() {
+	Arena::enter();
+}
+
+void NBind :: leaveArena() {
+	Arena::leave();
+}
+
 typedef BaseSignature :: SignatureType SignatureType;
 
+#if defined(NBIND_PROFILE)
+
+// Report profiled calls to functions in a list, if called at least once.
+
+static void reportCalls(
+	const char *className,
+	std::forward_list<MethodDef> &methodList,
+	cbFunction &outCall
+) {
+	for(auto &func : methodList) {
+		const BaseSignature *signature = func.getSignature();
+
+		if(signature == nullptr || signature->getType() == SignatureType :: construct) continue;
+
+		ProfileEntry &entry = ProfileScope::getEntry(signature->getProfileNum(func.getNum()));
+
+		if(entry.callCount == 0) continue;
+
+		std::string name = func.getName();
+
+		if(className != nullptr) name = std::string(className) + "." + name;
+
+		outCall(
+			name,
+			static_cast<double>(entry.callCount),
+			static_cast<double>(entry.exceptionCount),
+			static_cast<double>(entry.totalTime),
+			static_cast<double>(entry.argTime),
+			static_cast<double>(entry.bodyTime),
+			static_cast<double>(entry.returnTime),
+			std::vector<double>(entry.histogram, entry.histogram + ProfileEntry::bucketCount)
+		);
+	}
+}
+
+void NBind :: getCallStats(cbFunction &outCall) {
+	reportCalls(nullptr, getFunctionList(), outCall);
+
+	for(auto *bindClass : getClassList()) {
+		// Skip internal methods, including this one.
+		if(bindClass == &BindClass<NBind>::getInstance()) continue;
+
+		reportCalls(bindClass->getName(), bindClass->getMethodList(), outCall);
+	}
+}
+
+#endif // NBIND_PROFILE
+
+// Make a function template calling a bound function or method.
+
+static Local<FunctionTemplate> makeMethodTemplate(
+	const BaseSignature *signature,
+	SignatureParam *param
+) {
+	Local<FunctionTemplate> tmpl;
+
+#if NODE_MODULE_VERSION >= 14
+	funcPtr directCaller = signature->getDirectCaller();
+
+	// Signatures with only numeric and boolean types get called directly
+	// by V8, without an extra indirection through Nan's callback wrapper.
+
+	if(directCaller != nullptr) {
+		tmpl = FunctionTemplate::New(
+			Isolate::GetCurrent(),
+			reinterpret_cast<FunctionCallback>(directCaller),
+			Nan::New<v8::External>(param)
+		);
+	} else
+#endif
+	{
+		tmpl = Nan::New<FunctionTemplate>(
+			reinterpret_cast<BindClassBase::jsMethod *>(signature->getCaller()),
+			Nan::New<v8::External>(param)
+		);
+	}
+
+	funcPtr batchCaller = signature->getBatchCaller();
+
+	// Add a batch method calling the function once for each row
+	// in columns of arguments.
+
+	if(batchCaller != nullptr) {
+		Nan::SetTemplate(tmpl, "batch", Nan::New<FunctionTemplate>(
+			reinterpret_cast<BindClassBase::jsMethod *>(batchCaller),
+			Nan::New<v8::External>(param)
+		));
+	}
+
+	return(tmpl);
+}
+
 static void registerMethods(
 	BindClassBase &bindClass,
 	Local<FunctionTemplate> constructorTemplate,
@@ -137,6 +294,8 @@ static void registerMethods(
 		if(staticOnly && signature->getType() != SignatureType :: func) continue;
 
 		param = new SignatureParam();
+		param->className = bindClass.getName();
+		param->name = func.getName();
 
 		switch(signature->getType()) {
 			case SignatureType :: none:
@@ -147,10 +306,7 @@ static void registerMethods(
 			case SignatureType :: method:
 				param->methodNum = func.getNum();
 				Nan::SetPrototypeTemplate(constructorTemplate, func.getName(),
-					Nan::New<FunctionTemplate>(
-						reinterpret_cast<BindClassBase::jsMethod *>(signature->getCaller()),
-						Nan::New<v8::External>(param)
-					)
+					makeMethodTemplate(signature, param)
 				);
 
 				break;
@@ -158,10 +314,7 @@ static void registerMethods(
 			case SignatureType :: func:
 				param->methodNum = func.getNum();
 				Nan::SetTemplate(constructorTemplate, func.getName(),
-					Nan::New<FunctionTemplate>(
-						reinterpret_cast<BindClassBase::jsMethod *>(signature->getCaller()),
-						Nan::New<v8::External>(param)
-					)
+					makeMethodTemplate(signature, param)
 				);
 
 				break;
@@ -241,6 +394,260 @@ static void nop(const Nan::FunctionCallbackInfo<v8::Value> &args) {
 	args.GetReturnValue().Set(Nan::Undefined());
 }
 
+// Base class template of all C++ objects in the current thread.
+
+static Nan::Persistent<FunctionTemplate> &getSuperTemplate() {
+	static thread_local Nan::Persistent<FunctionTemplate> superTemplate;
+
+	return(superTemplate);
+}
+
+// Get the wrapper of a JavaScript object, or nullptr if it has none.
+// Other objects can have an internal field too, like the storage object
+// passed to fromJS, so check the class first like BindWrapper::testInstance.
+
+static BindWrapperBase *getWrapper(Local<Value> value) {
+	Nan::Persistent<FunctionTemplate> &superTemplate = getSuperTemplate();
+
+	if(!value->IsObject() || superTemplate.IsEmpty()) return(nullptr);
+
+	Local<Object> obj = value.As<Object>();
+
+	if(
+		!Nan::New(superTemplate)->HasInstance(obj) ||
+		obj->InternalFieldCount() != 1
+	) {
+		return(nullptr);
+	}
+
+	return(static_cast<BindWrapperBase *>(Nan::GetInternalFieldPointer(obj, 0)));
+}
+
+/** Keep the object when leaving binding.scope(). */
+
+static void persist(const Nan::FunctionCallbackInfo<v8::Value> &args) {
+	BindWrapperBase *wrapper = getWrapper(args.This());
+
+	if(wrapper != nullptr) wrapper->persist();
+
+	args.GetReturnValue().Set(Nan::Undefined());
+}
+
+/** Start recording wrappers for binding.scope(). */
+
+static void enterScope(const Nan::FunctionCallbackInfo<v8::Value> &args) {
+	BindWrapperBase::getScopeStack().emplace_back(
+		new Nan::Persistent<v8::Array>(Nan::New<v8::Array>())
+	);
+
+	args.GetReturnValue().Set(Nan::Undefined());
+}
+
+/** Free wrappers created since the matching enterScope call,
+  * except persistent ones and the first argument. */
+
+static void leaveScope(const Nan::FunctionCallbackInfo<v8::Value> &args) {
+	auto &scopeStack = BindWrapperBase::getScopeStack();
+
+	args.GetReturnValue().Set(Nan::Undefined());
+
+	if(scopeStack.empty()) return;
+
+	Local<v8::Array> list = Nan::New(*scopeStack.back());
+	Local<Value> result = args[0];
+
+	scopeStack.pop_back();
+
+	uint32_t count = list->Length();
+
+	for(uint32_t num = 0; num < count; ++num) {
+		Local<Value> obj = Nan::Get(list, num).ToLocalChecked();
+		BindWrapperBase *wrapper = getWrapper(obj);
+
+		if(wrapper == nullptr || wrapper->getPersistent()) continue;
+
+		if(obj->StrictEquals(result)) {
+			// The returned object now belongs to the surrounding scope, if any.
+
+			if(!scopeStack.empty()) {
+				Local<v8::Array> parent = Nan::New(*scopeStack.back());
+
+				Nan::Set(parent, parent->Length(), obj);
+			}
+
+			continue;
+		}
+
+		wrapper->destroy();
+	}
+}
+
+// Number of classes with a JavaScript constructor in the current thread.
+
+static unsigned int &getReadyCount() {
+	static thread_local unsigned int count = 0;
+
+	return(count);
+}
+
+/** Create a class constructor template and add its methods, if not done yet.
+  * The first superclass is set up first, to inherit its prototype. */
+
+static Local<FunctionTemplate> prepareClass(BindClassBase &bindClass) {
+	ClassState &state = bindClass.getState();
+
+	if(!state.constructorTemplate.IsEmpty()) return(Nan::New(state.constructorTemplate));
+
+	auto &superClassList = bindClass.getSuperClassList();
+	Local<FunctionTemplate> parentTemplate;
+
+	if(!superClassList.empty()) {
+		parentTemplate = prepareClass(superClassList.front().superClass);
+	} else {
+		parentTemplate = Nan::New(state.superTemplate);
+	}
+
+	SignatureParam *param = new SignatureParam();
+	param->overloadNum = bindClass.wrapperConstructorNum;
+	param->className = bindClass.getName();
+	param->name = "constructor";
+
+	auto constructorTemplate = Nan::New<FunctionTemplate>(
+		Overloader::create,
+		Nan::New<v8::External>(param)
+	);
+
+	constructorTemplate->SetClassName(Nan::New<String>(bindClass.getName()).ToLocalChecked());
+	constructorTemplate->InstanceTemplate()->SetInternalFieldCount(1);
+	constructorTemplate->Inherit(parentTemplate);
+
+	// Add methods of the class and all its superclasses not inherited
+	// through the prototype chain.
+
+	std::unordered_set<BindClassBase *> visitTbl;
+	registerSuperMethods(bindClass, 1, constructorTemplate, visitTbl);
+
+	Nan::SetPrototypeTemplate(constructorTemplate, "free",
+		Nan::New<FunctionTemplate>(
+			bindClass.getDeleter()
+		)
+	);
+
+	state.constructorTemplate.Reset(constructorTemplate);
+	state.instanceTemplate.Reset(constructorTemplate->InstanceTemplate());
+
+	return(constructorTemplate);
+}
+
+/** Instantiate the constructor template of a class, setting it up first. */
+
+static Local<Function> materializeClass(BindClassBase &bindClass) {
+	if(bindClass.isReady()) {
+		return(Overloader::getConstructorJS(bindClass.wrapperConstructorNum)->GetFunction());
+	}
+
+	// Superclass constructors must exist before the prototype chain
+	// of this class can be instantiated.
+
+	auto &superClassList = bindClass.getSuperClassList();
+
+	if(!superClassList.empty()) materializeClass(superClassList.front().superClass);
+
+	Local<Function> jsConstructor = Nan::GetFunction(prepareClass(bindClass)).ToLocalChecked();
+
+	Overloader::setConstructorJS(bindClass.wrapperConstructorNum, jsConstructor);
+
+	bindClass.setReady();
+	++getReadyCount();
+
+	return(jsConstructor);
+}
+
+v8::Local<v8::ObjectTemplate> BindClassBase :: getInstanceTemplate() {
+	ClassState &state = getState();
+
+	// Classes not registered in this thread remain unbound.
+
+	if(state.superTemplate.IsEmpty()) return(v8::Local<v8::ObjectTemplate>());
+
+	if(!isReady()) materializeClass(*this);
+
+	return(Nan::New(state.instanceTemplate));
+}
+
+void NBind :: getClassStats(cbFunction &outStats) {
+	auto &classList = getClassList();
+
+	outStats(
+		getReadyCount(),
+		static_cast<unsigned int>(std::distance(classList.begin(), classList.end()))
+	);
+}
+
+#if defined(NBIND_LAZY_CLASSES) && NODE_MODULE_VERSION >= 14 // >= Node.js 0.12
+
+/** Getter of an exported class, instantiating its constructor on first use. */
+
+static void getLazyClass(const Nan::FunctionCallbackInfo<v8::Value> &args) {
+	BindClassBase &bindClass = *static_cast<BindClassBase *>(args.Data().As<v8::External>()->Value());
+	Local<Function> jsConstructor = materializeClass(bindClass);
+
+	// Replace the accessor, so later lookups are plain property reads.
+
+	Nan::DefineOwnProperty(
+		args.This(),
+		Nan::New<String>(bindClass.getName()).ToLocalChecked(),
+		jsConstructor
+	).FromMaybe(false);
+
+	args.GetReturnValue().Set(jsConstructor);
+}
+
+#endif // NBIND_LAZY_CLASSES
+
+#if !defined(NBIND_DUPLICATE_POINTERS) && NODE_MODULE_VERSION >= 72 // >= Node.js 12
+
+// Heap snapshot node for the C++ object of a wrapper.
+
+class WrapperGraphNode : public v8::EmbedderGraph::Node {
+
+public:
+
+	WrapperGraphNode(const char *name, size_t size) : name(name), size(size) {}
+
+	const char *Name() override { return(name); }
+	size_t SizeInBytes() override { return(size); }
+
+private:
+
+	const char *name;
+	size_t size;
+
+};
+
+// Show C++ objects in heap snapshots, retained by their wrappers.
+
+static void buildEmbedderGraph(Isolate *isolate, EmbedderGraph *graph, void *data) {
+	Nan::HandleScope scope;
+
+	BindWrapperBase::getInstanceTbl().forEach([graph](BindWrapperBase *wrapper) {
+		if(wrapper->persistent().IsEmpty()) return;
+
+		Local<Value> handle = wrapper->handle();
+
+		EmbedderGraph::Node *node = graph->AddNode(
+			std::unique_ptr<EmbedderGraph::Node>(new WrapperGraphNode(
+				wrapper->getClassName(),
+				wrapper->getExternalSize()
+			))
+		);
+
+		graph->AddEdge(graph->V8Node(handle), node);
+	});
+}
+
+#endif // NBIND_DUPLICATE_POINTERS, NODE_MODULE_VERSION
+
 static void initModule(Local<Object> exports) {
 	SignatureParam *param;
 
@@ -249,11 +656,9 @@ static void initModule(Local<Object> exports) {
 
 		param = new SignatureParam();
 		param->methodNum = func.getNum();
+		param->name = func.getName();
 
-		Local<FunctionTemplate> functionTemplate = Nan::New<FunctionTemplate>(
-			reinterpret_cast<BindClassBase::jsMethod *>(signature->getCaller()),
-			Nan::New<v8::External>(param)
-		);
+		Local<FunctionTemplate> functionTemplate = makeMethodTemplate(signature, param);
 
 		Local<v8::Function> jsFunction = Nan::GetFunction(functionTemplate).ToLocalChecked();
 
@@ -267,107 +672,94 @@ static void initModule(Local<Object> exports) {
 
 	Local<FunctionTemplate> superTemplate = Nan::New<FunctionTemplate>(nop);
 
+	Nan::SetPrototypeTemplate(superTemplate, "persist", Nan::New<FunctionTemplate>(persist));
+
+	getSuperTemplate().Reset(superTemplate);
+
 	// Wrapper for temporary data pointer when passing objects by value.
 
 	auto storageTemplate = Nan::New<ObjectTemplate>();
 	storageTemplate->SetInternalFieldCount(1);
 	Nan::SetCallAsFunctionHandler(storageTemplate, Overloader::createValue);
 
-	// Create all class constructor templates.
-
 	auto &classList = getClassList();
 
-	for(auto *bindClass : classList) bindClass->unvisit();
-
-	auto posPrev = classList.before_begin();
-	auto pos = classList.begin();
+	// Worker threads may load the addon simultaneously, but the class list
+	// is shared between them. Remove duplicates only once, before any thread
+	// iterates over the list. Other threads wait here until it's done.
 
-	while(pos != classList.end()) {
-		auto *bindClass = *pos++;
+	static std::once_flag classListFlag;
 
-		// Avoid registering the same class twice.
-		if(bindClass->isVisited()) {
-			classList.erase_after(posPrev);
-			continue;
-		}
+	std::call_once(classListFlag, [&classList]() {
+		for(auto *bindClass : classList) bindClass->unvisit();
 
-		bindClass->visit();
-		++posPrev;
+		auto posPrev = classList.before_begin();
+		auto pos = classList.begin();
 
-		if(bindClass->isReady()) continue;
+		while(pos != classList.end()) {
+			auto *bindClass = *pos++;
 
-		param = new SignatureParam();
-		param->overloadNum = bindClass->wrapperConstructorNum;
-
-		auto constructorTemplate = Nan::New<FunctionTemplate>(
-			Overloader::create,
-			Nan::New<v8::External>(param)
-		);
-
-		constructorTemplate->SetClassName(Nan::New<String>(bindClass->getName()).ToLocalChecked());
-		constructorTemplate->InstanceTemplate()->SetInternalFieldCount(1);
-
-		bindClass->constructorTemplate.Reset(constructorTemplate);
-		bindClass->superTemplate.Reset(superTemplate);
-		bindClass->storageTemplate.Reset(storageTemplate);
-	}
-
-	// Add NBind reference to base class to enforce its visibility.
+			// Avoid registering the same class twice.
+			if(bindClass->isVisited()) {
+				classList.erase_after(posPrev);
+				continue;
+			}
 
-	Nan::SetTemplate(
-		superTemplate,
-		"NBind",
-		Nan::New(BindClass<NBind>::getInstance().constructorTemplate)
-	);
+			bindClass->visit();
+			++posPrev;
 
-	// Define inheritance between class constructor templates and add methods.
+			Overloader::setPtrWrapper(bindClass->wrapperConstructorNum, bindClass->wrapPtr);
+		}
+	});
 
 	for(auto *bindClass : classList) {
 		if(bindClass->isReady()) continue;
 
-		Local<FunctionTemplate> constructorTemplate = Nan::New(bindClass->constructorTemplate);
+		ClassState &state = bindClass->getState();
 
-		auto superClassList = bindClass->getSuperClassList();
+		state.superTemplate.Reset(superTemplate);
+		state.storageTemplate.Reset(storageTemplate);
+	}
 
-		if(!superClassList.empty()) {
-			// This fails if the constructor template of any other child class
-			// has already been instantiated!
-			// TODO: Is this correct? What the superclass inherits may still
-			// be undefined. Should this be in registerSuperMethods instead?
-			constructorTemplate->Inherit(Nan::New(superClassList.front().superClass.constructorTemplate));
-		} else {
-			constructorTemplate->Inherit(superTemplate);
-		}
+	// Add NBind reference to base class to enforce its visibility.
+	// The NBind class must be set up before instantiating any class
+	// template, because they all inherit the base class.
 
-		// Add methods of the class and all its superclasses not inherited
-		// through the prototype chain.
+	Local<FunctionTemplate> nbindTemplate = prepareClass(BindClass<NBind>::getInstance());
 
-		std::unordered_set<BindClassBase *> visitTbl;
-		registerSuperMethods(*bindClass, 1, constructorTemplate, visitTbl);
+	// Scopes handle any JavaScript values, so their functions are bound directly.
 
-		Nan::SetPrototypeTemplate(constructorTemplate, "free",
-			Nan::New<FunctionTemplate>(
-				bindClass->getDeleter()
-			)
-		);
-	}
+	Nan::SetTemplate(nbindTemplate, "enterScope", Nan::New<FunctionTemplate>(enterScope));
+	Nan::SetTemplate(nbindTemplate, "leaveScope", Nan::New<FunctionTemplate>(leaveScope));
+
+	Nan::SetTemplate(superTemplate, "NBind", nbindTemplate);
 
 	// Instantiate and export class constructor templates.
+	// In lazy mode, only set up getters to instantiate them when accessed.
 
 	for(auto *bindClass : classList) {
-		// Instantiate the constructor template.
-		Local<Function> jsConstructor = Nan::GetFunction(Nan::New(bindClass->constructorTemplate)).ToLocalChecked();
+		Local<String> name = Nan::New<String>(bindClass->getName()).ToLocalChecked();
 
-		Overloader::setConstructorJS(bindClass->wrapperConstructorNum, jsConstructor);
-		Overloader::setPtrWrapper(bindClass->wrapperConstructorNum, bindClass->wrapPtr);
+#		if defined(NBIND_LAZY_CLASSES) && NODE_MODULE_VERSION >= 14 // >= Node.js 0.12
+			if(bindClass != &BindClass<NBind>::getInstance() && !bindClass->isReady()) {
+				exports->SetAccessorProperty(
+					name,
+					Nan::New<v8::Function>(getLazyClass, Nan::New<v8::External>(bindClass))
+				);
 
-		exports->Set(
-			Nan::New<String>(bindClass->getName()).ToLocalChecked(),
-			jsConstructor
-		);
+				continue;
+			}
+#		endif // NBIND_LAZY_CLASSES
 
-		bindClass->setReady();
+		exports->Set(name, materializeClass(*bindClass));
 	}
+
+#	if !defined(NBIND_DUPLICATE_POINTERS) && NODE_MODULE_VERSION >= 72
+		Isolate::GetCurrent()->GetHeapProfiler()->AddBuildEmbedderGraphCallback(
+			buildEmbedderGraph,
+			nullptr
+		);
+#	endif
 }
 
 #include "nbind/nbind.h"
@@ -378,12 +770,29 @@ NBIND_CLASS(NBind) {
 	method(bind_value);
 	method(reflect);
 	method(queryType);
+	method(getStringCacheStats);
+	method(getWrapperTableStats);
+	method(getClassStats);
+	method(getLiveObjects);
+	method(setAllocationSampling);
+#	if defined(NBIND_PROFILE)
+		method(getCallStats);
+#	endif
+	method(enterArena);
+	method(leaveArena);
 }
 
 NBIND_CLASS(NBindID) {
 	method(toString);
 }
 
-NODE_MODULE(nbind, initModule)
+#if defined(NAN_MODULE_WORKER_ENABLED)
+	// Allow loading in worker threads. Each thread has its own V8 isolate,
+	// and nbind keeps JavaScript objects separately for each thread.
+
+	NAN_MODULE_WORKER_ENABLED(nbind, initModule)
+#else
+	NODE_MODULE(nbind, initModule)
+#endif
 
 #endif
@@ -0,0 +1,55 @@
+// This file is part of nbind, copyright (C) 2014-2016 BusFaster Ltd.
+// Released under the MIT license, see LICENSE.
+
+#include "nbind/api.h"
+
+class ArenaItem {
+
+public:
+
+	ArenaItem(int value) : value(value) { ++getLive(); }
+
+	~ArenaItem() { --getLive(); }
+
+	int getValue() { return(value); }
+
+	static unsigned int countLive() { return(getLive()); }
+
+private:
+
+	static unsigned int &getLive() {
+		static unsigned int live = 0;
+
+		return(live);
+	}
+
+	int value;
+
+};
+
+namespace nbind {
+
+template<> struct ArenaAllocated<ArenaItem> : public std::true_type {};
+
+#if defined(BUILDING_NODE_EXTENSION)
+
+// Outside arenas, objects are stored inline with their wrapper.
+
+template<> struct InlineStorage<ArenaItem> : public std::true_type {};
+
+#endif
+
+} // namespace
+
+#include "nbind/nbind.h"
+
+#ifdef NBIND_CLASS
+
+NBIND_CLASS(ArenaItem) {
+	construct<int>();
+
+	method(getValue);
+	method(countLive);
+}
+
+#endif
@@ -44,6 +44,20 @@ public:
 		return(callback.call<std::vector<std::string>>(a));
 	}
 
+	static double sumDoubles(std::vector<double> a) {
+		double sum = 0;
+
+		for(double item : a) sum += item;
+
+		return(sum);
+	}
+
+	static std::vector<double> getDoubles() {
+		std::vector<double> a {{ 0.5, 1.5, 2.5 }};
+
+		return(a);
+	}
+
 };
 
 #include "nbind/nbind.h"
@@ -54,6 +68,7 @@ NBIND_CLASS(Array) {
 	construct<>();
 
 	method(getInts);
+	method(getInts, "getIntsTyped", nbind::TypedArray());
 	method(callWithInts);
 }
 
@@ -63,6 +78,9 @@ NBIND_CLASS(Vector) {
 	method(getInts);
 	method(callWithInts);
 	method(callWithStrings);
+	method(sumDoubles);
+	method(getDoubles);
+	method(getDoubles, "getDoublesTyped", nbind::TypedArray());
 }
 
 #endif
@@ -0,0 +1,70 @@
+// This file is part of nbind, copyright (C) 2014-2016 BusFaster Ltd.
+// Released under the MIT license, see LICENSE.
+
+#include <stdexcept>
+#include <string>
+
+#include "nbind/api.h"
+
+class AsyncWork {
+
+public:
+
+	AsyncWork(int base) : base(base) { ++getLive(); }
+
+	~AsyncWork() { --getLive(); }
+
+	int add(int x) { return(base + x); }
+
+	static int addTo(AsyncWork *work, int x) { return(work->add(x)); }
+
+	static double sumTo(unsigned int count) {
+		double sum = 0;
+
+		for(unsigned int num = 1; num <= count; ++num) sum += num;
+
+		return(sum);
+	}
+
+	static std::string repeat(const char *str, unsigned int count) {
+		std::string result;
+
+		while(count--) result += str;
+
+		return(result);
+	}
+
+	static void fail(std::string message) {
+		throw(std::runtime_error(message));
+	}
+
+	static unsigned int countLive() { return(getLive()); }
+
+private:
+
+	static unsigned int &getLive() {
+		static unsigned int live = 0;
+
+		return(live);
+	}
+
+	int base;
+
+};
+
+#include "nbind/nbind.h"
+
+#ifdef NBIND_CLASS
+
+NBIND_CLASS(AsyncWork) {
+	construct<int>();
+
+	method(add, nbind::Async());
+	method(addTo, nbind::Async());
+	method(sumTo, nbind::Async());
+	method(repeat, nbind::Async());
+	method(fail, nbind::Async());
+	method(countLive);
+}
+
+#endif
@@ -2,6 +2,7 @@
 // Released under the MIT license, see LICENSE.
 
 #include <array>
+#include <string>
 #include <vector>
 
 #include "nbind/api.h"
@@ -37,6 +38,71 @@ public:
 		buf.commit();
 	}
 
+	static nbind::Buffer range(unsigned int length) {
+		nbind::Buffer buf = nbind::Buffer::alloc(length);
+		unsigned char *data = buf.data();
+
+		for(size_t pos = 0; pos < length; ++pos) {
+			data[pos] = pos;
+		}
+
+		return(buf);
+	}
+
+	static std::vector<unsigned char> rangeVector(unsigned int length) {
+		std::vector<unsigned char> result(length);
+
+		for(size_t pos = 0; pos < length; ++pos) {
+			result[pos] = pos;
+		}
+
+		return(result);
+	}
+
+	static std::string rangeString(unsigned int length) {
+		std::string result(length, '\0');
+
+		for(size_t pos = 0; pos < length; ++pos) {
+			result[pos] = pos;
+		}
+
+		return(result);
+	}
+
+};
+
+class TypedView {
+
+public:
+
+	TypedView(unsigned int count) : values(count) {
+		for(unsigned int num = 0; num < count; ++num) values[num] = num;
+	}
+
+	static double sum(nbind::Span<double> span) {
+		double sum = 0;
+
+		for(double item : span) sum += item;
+
+		return(sum);
+	}
+
+	static void scale(nbind::ArrayView<float> view, float factor) {
+		for(size_t pos = 0; pos < view.size(); ++pos) {
+			view[pos] *= factor;
+		}
+
+		view.commit();
+	}
+
+	nbind::Span<double> getValues() {
+		return(nbind::Span<double>(values.data(), values.size()));
+	}
+
+	double get(unsigned int num) { return(values[num]); }
+
+	std::vector<double> values;
+
 };
 
 #include "nbind/nbind.h"
@@ -46,6 +112,18 @@ public:
 NBIND_CLASS(Buffer) {
 	method(sum);
 	method(mul2);
+	method(range);
+	method(rangeVector, nbind::Bytes());
+	method(rangeString, nbind::Bytes());
+}
+
+NBIND_CLASS(TypedView) {
+	construct<unsigned int>();
+
+	method(sum);
+	method(scale);
+	method(getValues);
+	method(get);
 }
 
 #endif
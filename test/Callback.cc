@@ -2,7 +2,13 @@
 // Released under the MIT license, see LICENSE.
 
 #include <cstring>
+#include <memory>
 #include <string>
+#include <vector>
+
+#if !defined(__EMSCRIPTEN__)
+#	include <thread>
+#endif
 
 #include "nbind/api.h"
 
@@ -33,6 +39,37 @@ public:
 		cb(foo, bar, baz);
 	}
 
+	// Post numbers 0 to count - 1 from several threads (only one in asm.js).
+
+	static void postFromThreads(nbind::cbFunction &cb, unsigned int threadCount, unsigned int count, bool coalesce) {
+		getQueue().reset(new nbind::cbQueue<unsigned int>(cb, coalesce));
+		nbind::cbQueue<unsigned int> *queue = getQueue().get();
+
+#		if defined(__EMSCRIPTEN__)
+			for(unsigned int num = 0; num < count; ++num) queue->post(num);
+#		else
+			std::vector<std::thread> threadList;
+
+			for(unsigned int thread = 0; thread < threadCount; ++thread) {
+				threadList.emplace_back([=]() {
+					for(unsigned int num = thread; num < count; num += threadCount) queue->post(num);
+				});
+			}
+
+			for(auto &thread : threadList) thread.join();
+#		endif
+	}
+
+	static void closeQueue() { getQueue().reset(); }
+
+private:
+
+	static std::unique_ptr<nbind::cbQueue<unsigned int>> &getQueue() {
+		static std::unique_ptr<nbind::cbQueue<unsigned int>> queue;
+
+		return(queue);
+	}
+
 };
 
 #include "nbind/nbind.h"
@@ -57,6 +94,9 @@ NBIND_CLASS(Callback) {
 	method(callCatenate2);
 
 	method(callCStrings);
+
+	method(postFromThreads);
+	method(closeQueue);
 }
 
 #endif
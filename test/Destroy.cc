@@ -0,0 +1,96 @@
+// This file is part of nbind, copyright (C) 2014-2016 BusFaster Ltd.
+// Released under the MIT license, see LICENSE.
+
+#include <atomic>
+#include <thread>
+
+#include "nbind/api.h"
+
+class IdleItem {
+
+public:
+
+	IdleItem() { ++getLive(); }
+
+	~IdleItem() { --getLive(); }
+
+	static unsigned int countLive() { return(getLive()); }
+
+private:
+
+	static std::atomic<unsigned int> &getLive() {
+		static std::atomic<unsigned int> live(0);
+
+		return(live);
+	}
+
+};
+
+class ThreadItem {
+
+public:
+
+	ThreadItem() : thread(std::this_thread::get_id()) { ++getLive(); }
+
+	~ThreadItem() {
+		if(std::this_thread::get_id() != thread) ++getOffThread();
+		--getLive();
+	}
+
+	static unsigned int countLive() { return(getLive()); }
+
+	// Number of objects destroyed in a different thread than constructed.
+
+	static unsigned int countOffThread() { return(getOffThread()); }
+
+private:
+
+	static std::atomic<unsigned int> &getLive() {
+		static std::atomic<unsigned int> live(0);
+
+		return(live);
+	}
+
+	static std::atomic<unsigned int> &getOffThread() {
+		static std::atomic<unsigned int> count(0);
+
+		return(count);
+	}
+
+	std::thread::id thread;
+
+};
+
+namespace nbind {
+
+template<> struct DestroyPolicy<IdleItem> : public DestroyWhenIdle {};
+template<> struct DestroyPolicy<ThreadItem> : public DestroyInThread {};
+
+#if defined(BUILDING_NODE_EXTENSION)
+
+// Test policies with both inline and separately allocated objects.
+
+template<> struct InlineStorage<IdleItem> : public std::true_type {};
+
+#endif
+
+} // namespace
+
+#include "nbind/nbind.h"
+
+#ifdef NBIND_CLASS
+
+NBIND_CLASS(IdleItem) {
+	construct<>();
+
+	method(countLive);
+}
+
+NBIND_CLASS(ThreadItem) {
+	construct<>();
+
+	method(countLive);
+	method(countOffThread);
+}
+
+#endif
@@ -53,6 +53,18 @@ public:
 		return(x + y);
 	}
 
+	static unsigned int byteLength(const std::string &x) {
+		return(x.length());
+	}
+
+	static const char *getStaticName(int num) {
+		return(num ? "true" : "false");
+	}
+
+	static std::string getInternedName(int num) {
+		return(num ? "true" : "false");
+	}
+
 	template <typename T>
 	static T toInt(double x) {
 		T y = x;
@@ -115,6 +127,9 @@ NBIND_CLASS(PrimitiveMethods) {
 	method(catenateStatic);
 	method(catenate);
 	method(catenate2);
+	method(byteLength);
+	method(getStaticName, nbind::StaticString());
+	method(getInternedName, nbind::Interned());
 
 	method(ftol);
 	method(ftoul);
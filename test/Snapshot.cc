@@ -0,0 +1,30 @@
+// This file is part of nbind, copyright (C) 2014-2016 BusFaster Ltd.
+// Released under the MIT license, see LICENSE.
+
+// Large object, found in heap snapshots by its size.
+
+class SnapshotItem {
+
+public:
+
+	SnapshotItem() : data() {}
+
+	static unsigned int getSize() { return(sizeof(SnapshotItem)); }
+
+private:
+
+	char data[1000];
+
+};
+
+#include "nbind/nbind.h"
+
+#ifdef NBIND_CLASS
+
+NBIND_CLASS(SnapshotItem) {
+	construct<>();
+
+	method(getSize);
+}
+
+#endif
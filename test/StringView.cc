@@ -0,0 +1,36 @@
+// This file is part of nbind, copyright (C) 2014-2016 BusFaster Ltd.
+// Released under the MIT license, see LICENSE.
+
+// Only compiled in the C++17 test build (node-gyp configure --cxx17=1).
+
+#include <string>
+#include <string_view>
+
+class StringView {
+
+public:
+
+	static size_t getLength(std::string_view str) { return(str.length()); }
+
+	// Both arguments must have their own storage.
+
+	static std::string concat(std::string_view a, std::string_view b) {
+		return(std::string(a) + std::string(b));
+	}
+
+	static std::string_view getStatic() { return("static"); }
+
+};
+
+#include "nbind/nbind.h"
+
+#ifdef NBIND_CLASS
+
+NBIND_CLASS(StringView) {
+	method(getLength);
+	method(concat);
+	method(getStatic);
+	method(concat, "strictConcat", nbind::Strict());
+}
+
+#endif
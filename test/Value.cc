@@ -6,6 +6,25 @@
 #include "nbind/api.h"
 #include "Coord.h"
 
+// Value object converted through fields listed in NBIND_CLASS.
+
+class Size {
+
+public:
+
+	Size() : width(0), height(0) {}
+
+	Size(unsigned int width, unsigned int height) : width(width), height(height) {}
+
+	void toJS(nbind::cbOutput output) {
+		output(width, height);
+	}
+
+	unsigned int width;
+	unsigned int height;
+
+};
+
 class Value {
 
 public:
@@ -20,6 +39,18 @@ public:
 		return(callback.call<Coord>(a, b));
 	}
 
+	static unsigned int sumCoord(Coord a, Coord b) {
+		return(a.x + a.y + b.x + b.y);
+	}
+
+	static Size getSize() {
+		return(Size(640, 480));
+	}
+
+	static unsigned int getArea(Size size) {
+		return(size.width * size.height);
+	}
+
 };
 
 #include "nbind/nbind.h"
@@ -30,11 +61,21 @@ NBIND_CLASS(Coord) {
 	construct<unsigned int, unsigned int>();
 }
 
+NBIND_CLASS(Size) {
+	construct<unsigned int, unsigned int>();
+
+	field(width);
+	field(height);
+}
+
 NBIND_CLASS(Value) {
 	construct<>();
 
 	method(getCoord);
 	method(callWithCoord);
+	method(sumCoord);
+	method(getSize);
+	method(getArea);
 }
 
 #endif
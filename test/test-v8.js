@@ -0,0 +1,452 @@
+var nbind = require('..');
+var test = require('tap').test;
+
+var binding = nbind.init();
+var testModule = binding.lib;
+
+test('Lazy classes', function(t) {
+	var stats = binding.classStats();
+
+	// Only some classes are ready before first use in the lazy test build.
+	// This runs first so no other test has accessed the class yet.
+
+	if(stats.ready == stats.total) {
+		t.end();
+		return;
+	}
+
+	var Type = testModule.ThreadItem;
+
+	t.type(Type, 'function');
+	t.strictEqual(binding.classStats().ready, stats.ready + 1);
+
+	// Later lookups read the materialized constructor.
+
+	t.strictEqual(testModule.ThreadItem, Type);
+	t.strictEqual(binding.classStats().ready, stats.ready + 1);
+
+	t.end();
+});
+
+test('Argument checks', function(t) {
+	t.throws(
+		function() {
+			testModule.PrimitiveMethods.incrementIntStatic(42, null);
+		},
+		new Error('Wrong number of arguments, expected 1')
+	);
+
+	// All arguments are checked before converting any of them,
+	// so a wrong second argument stops the first one's fromJS.
+
+	var converted = false;
+	var coord = {
+		fromJS: function(output) {
+			converted = true;
+			output(1, 2);
+		}
+	};
+
+	t.throws(function() {
+		testModule.Value.sumCoord(coord, 42);
+	}, new Error('Type mismatch'));
+
+	t.notOk(converted);
+
+	t.strictEqual(testModule.Value.sumCoord(coord, coord), 6);
+	t.ok(converted);
+
+	t.end();
+});
+
+test('Value object conversion cache', function(t) {
+	var Type = testModule.Value;
+
+	function Coord(x, y) {
+		this.x = x;
+		this.y = y;
+	}
+
+	Coord.prototype.fromJS = function(output) {
+		output(this.x, this.y);
+	};
+
+	// Objects with a fromJS method of their own or from different
+	// prototypes are converted as well.
+
+	var literal = { fromJS: function(output) { output(1, 2); } };
+
+	t.strictEqual(Type.sumCoord(new Coord(10, 20), new Coord(30, 40)), 100);
+	t.strictEqual(Type.sumCoord(literal, new Coord(3, 4)), 10);
+	t.strictEqual(Type.sumCoord(new Coord(3, 4), literal), 10);
+
+	t.throws(function() {
+		Type.sumCoord({}, literal);
+	}, new Error('Type mismatch'));
+
+	// An own fromJS overrides the cached one from the prototype.
+
+	var own = new Coord(10, 20);
+
+	own.fromJS = function(output) { output(1, 2); };
+
+	t.strictEqual(Type.sumCoord(new Coord(3, 4), own), 10);
+
+	// Replacing fromJS on the prototype takes effect.
+
+	Coord.prototype.fromJS = function(output) { output(0, 0); };
+
+	t.strictEqual(Type.sumCoord(new Coord(3, 4), new Coord(5, 6)), 0);
+
+	t.end();
+});
+
+test('Value object fields', function(t) {
+	var Type = testModule.Value;
+
+	// Without a bound JavaScript class, plain objects are created.
+
+	var size = Type.getSize();
+
+	t.strictEqual(size.width, 640);
+	t.strictEqual(size.height, 480);
+
+	// Any object with matching properties converts, no fromJS needed.
+
+	t.strictEqual(Type.getArea({ width: 3, height: 4 }), 12);
+	t.strictEqual(Type.getArea(size), 640 * 480);
+
+	function Size(width, height) {
+		this.width = width;
+		this.height = height;
+	}
+
+	Size.prototype.getArea = function() {
+		return(this.width * this.height);
+	};
+
+	binding.bind('Size', Size);
+
+	size = Type.getSize();
+
+	t.ok(size instanceof Size);
+	t.strictEqual(size.getArea(), 640 * 480);
+	t.strictEqual(Type.getArea(new Size(5, 6)), 30);
+
+	t.throws(function() {
+		Type.getArea(42);
+	}, new Error('Type mismatch'));
+
+	// Missing fields are errors, not zeroes.
+
+	t.throws(function() {
+		Type.getArea({ width: 3 });
+	}, new Error('Type mismatch'));
+
+	t.end();
+});
+
+test('Persist on other objects', function(t) {
+	var persist = testModule.Value.prototype.persist;
+
+	// Only wrappers of C++ objects are affected, not other objects
+	// with an internal field like the storage passed to fromJS.
+
+	var coord = {
+		fromJS: function(output) {
+			persist.call(output);
+			output(1, 2);
+		}
+	};
+
+	persist.call({});
+	t.strictEqual(testModule.Value.sumCoord(coord, coord), 6);
+
+	t.end();
+});
+
+test('Wrapper table', function(t) {
+	var Type = testModule.Reference;
+	var stats = binding.wrapperTableStats();
+
+	// The same pointer gets the same wrapper.
+
+	var ptr = Type.getPtr();
+	t.strictEqual(Type.getPtr(), ptr);
+
+	var after = binding.wrapperTableStats();
+
+	t.ok(after.size >= 1);
+	t.ok(after.capacity > after.size);
+	t.ok(after.lookups >= stats.lookups + 2);
+	t.ok(after.probes >= after.lookups);
+
+	t.end();
+});
+
+test('String cache', function(t) {
+	var Type = testModule.PrimitiveMethods;
+	var stats = binding.stringCacheStats();
+
+	Type.getStaticName(1);
+	Type.getStaticName(1);
+	Type.getInternedName(0);
+	Type.getInternedName(0);
+
+	var after = binding.stringCacheStats();
+
+	t.ok(after.hits >= stats.hits + 2);
+	t.ok(after.size >= 2);
+
+	t.end();
+});
+
+test('Deferred destruction', function(t) {
+	var Idle = testModule.IdleItem;
+	var Thread = testModule.ThreadItem;
+	var idleCount = Idle.countLive();
+	var threadCount = Thread.countLive();
+	var offThread = Thread.countOffThread();
+
+	(function() {
+		new Idle();
+		new Thread();
+	})();
+
+	t.strictEqual(Idle.countLive(), idleCount + 1);
+
+	gc();
+
+	// The garbage collector only queued the idle object for destruction.
+
+	t.strictEqual(Idle.countLive(), idleCount + 1);
+
+	var tries = 0;
+
+	function check() {
+		if(Thread.countLive() != threadCount && ++tries < 100) {
+			setTimeout(check, 10);
+			return;
+		}
+
+		t.strictEqual(Idle.countLive(), idleCount);
+		t.strictEqual(Thread.countLive(), threadCount);
+		t.strictEqual(Thread.countOffThread(), offThread + 1);
+
+		t.end();
+	}
+
+	setTimeout(check, 10);
+});
+
+test('Async arguments', function(t) {
+	var Type = testModule.AsyncWork;
+	var count = Type.countLive();
+	var obj = new Type(40);
+
+	var promise = Type.addTo(obj, 2);
+
+	// The pending call keeps the argument alive after free().
+
+	obj.free();
+	t.strictEqual(Type.countLive(), count + 1);
+
+	promise.then(function(result) {
+		t.strictEqual(result, 42);
+		t.end();
+	}, function(err) {
+		t.fail(err.message);
+		t.end();
+	});
+});
+
+test('String views', function(t) {
+	var Type = testModule.StringView;
+
+	// Only available in the C++17 test build.
+
+	if(!Type) {
+		t.end();
+		return;
+	}
+
+	t.strictEqual(Type.getLength('foobar'), 6);
+	t.strictEqual(Type.getLength(42), 2);
+	t.strictEqual(Type.concat('foo', 'bar'), 'foobar');
+	t.strictEqual(Type.getStatic(), 'static');
+
+	t.throws(function() {
+		Type.strictConcat('foo', 42);
+	}, new Error('Type mismatch'));
+
+	t.end();
+});
+
+test('Worker threads', function(t) {
+	var threads;
+
+	try {
+		threads = require('worker_threads');
+	} catch(err) {}
+
+	if(!threads) {
+		t.end();
+		return;
+	}
+
+	// Load the addon in two workers at once. Each binds its own JavaScript
+	// value class and converts objects in both directions.
+
+	var code = [
+		'var threads = require("worker_threads");',
+		'var nbind = require(' + JSON.stringify(require('path').resolve(__dirname, '..')) + ');',
+		'var binding = nbind.init(' + JSON.stringify(process.cwd()) + ');',
+		'var lib = binding.lib;',
+		'function Coord(x, y) { this.x = x; this.y = y; }',
+		'Coord.prototype.fromJS = function(output) { output(this.x, this.y); };',
+		'binding.bind("Coord", Coord);',
+		'var ok = true;',
+		'for(var num = 0; num < 1000; ++num) {',
+		'	var obj = new lib.Value();',
+		'	var coord = lib.Value.getCoord();',
+		'	ok = ok && obj instanceof lib.Value && coord instanceof Coord;',
+		'	ok = ok && lib.Value.sumCoord(coord, new Coord(num, 1)) == 60 + 25 + num + 1;',
+		'	ok = ok && lib.Value.getArea(lib.Value.getSize()) == 640 * 480;',
+		'}',
+		'threads.parentPort.postMessage(ok);'
+	].join('\n');
+
+	var pending = 2;
+
+	function start() {
+		var worker = new threads.Worker(code, { eval: true });
+
+		worker.on('message', function(ok) {
+			t.ok(ok);
+		});
+
+		worker.on('error', function(err) {
+			t.error(err);
+		});
+
+		worker.on('exit', function(code) {
+			t.strictEqual(code, 0);
+			if(--pending == 0) t.end();
+		});
+	}
+
+	start();
+	start();
+});
+
+test('Trace events', function(t) {
+	var major = +process.versions.node.split('.')[0];
+
+	// Trace events from addons need Node.js 12 or newer.
+
+	if(major < 12) {
+		t.end();
+		return;
+	}
+
+	var fs = require('fs');
+	var path = require('path');
+	var traceFile = path.join(require('os').tmpdir(), 'nbind-trace-' + process.pid + '.log');
+
+	var code = [
+		'var nbind = require(' + JSON.stringify(path.resolve(__dirname, '..')) + ');',
+		'var lib = nbind.init(' + JSON.stringify(process.cwd()) + ').lib;',
+		'var literal = { fromJS: function(output) { output(1, 2); } };',
+		'for(var num = 0; num < 3; ++num) lib.PrimitiveMethods.incrementIntStatic(num);',
+		'lib.Value.sumCoord(literal, literal);'
+	].join('\n');
+
+	var child = require('child_process').spawn(process.execPath, [
+		'--trace-event-categories', 'nbind',
+		'--trace-event-file-pattern', traceFile,
+		'-e', code
+	], { stdio: 'inherit' });
+
+	child.on('exit', function(status) {
+		t.strictEqual(status, 0);
+
+		var eventList = JSON.parse(fs.readFileSync(traceFile, 'utf8')).traceEvents.filter(
+			function(event) { return(event.cat == 'nbind'); }
+		);
+
+		fs.unlinkSync(traceFile);
+
+		// Begin and end events must nest properly in each thread.
+
+		var stackTbl = {};
+		var callCount = 0;
+		var fromJSCount = 0;
+
+		eventList.forEach(function(event) {
+			var stack = stackTbl[event.tid] || (stackTbl[event.tid] = []);
+
+			if(event.ph == 'B') {
+				stack.push(event.name);
+
+				if(event.name == 'incrementIntStatic') {
+					t.strictEqual(event.args['class'], 'PrimitiveMethods');
+					++callCount;
+				}
+
+				if(event.name == 'fromJS') {
+					t.strictEqual(event.args['class'], 'Coord');
+					++fromJSCount;
+				}
+			} else if(event.ph == 'E') {
+				t.strictEqual(stack.pop(), event.name);
+			}
+		});
+
+		for(var tid in stackTbl) t.strictEqual(stackTbl[tid].length, 0);
+
+		t.strictEqual(callCount, 3);
+		t.strictEqual(fromJSCount, 2);
+
+		t.end();
+	});
+});
+
+test('Heap snapshot', function(t) {
+	var v8 = require('v8');
+
+	// Embedder graph nodes need Node.js 12 and getHeapSnapshot.
+
+	if(+process.versions.node.split('.')[0] < 12 || !v8.getHeapSnapshot) {
+		t.end();
+		return;
+	}
+
+	var Type = testModule.SnapshotItem;
+	var obj = new Type();
+	var chunkList = [];
+
+	v8.getHeapSnapshot().on('data', function(chunk) {
+		chunkList.push(chunk);
+	}).on('end', function() {
+		var snapshot = JSON.parse(chunkList.join(''));
+		var fieldList = snapshot.snapshot.meta.node_fields;
+		var nameField = fieldList.indexOf('name');
+		var sizeField = fieldList.indexOf('self_size');
+		var nodeList = snapshot.nodes;
+		var found = 0;
+
+		for(var pos = 0; pos < nodeList.length; pos += fieldList.length) {
+			if(
+				snapshot.strings[nodeList[pos + nameField]] == 'SnapshotItem' &&
+				nodeList[pos + sizeField] == Type.getSize()
+			) ++found;
+		}
+
+		t.ok(found >= 1);
+
+		// Keep the object alive until the snapshot is done.
+
+		t.type(obj, Type);
+		t.end();
+	});
+});
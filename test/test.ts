@@ -81,6 +81,22 @@ test('Methods and primitive types', function(t: any) {
 
 		t.strictEqual(Type.strLengthStatic(123 as any as string), 3);
 
+		// Strings are passed as UTF-8 with any zero bytes included.
+
+		t.strictEqual(Type.byteLength('foo\0bar'), 7);
+		t.strictEqual(Type.byteLength('\u00e9t\u00e9'), 5);
+		t.strictEqual(Type.byteLength('\u20ac'), 3);
+
+		const longStr = new Array(301).join('\u00e9');
+
+		t.strictEqual(Type.byteLength(longStr), 600);
+		t.strictEqual(obj.catenate2(longStr, 'x'), longStr + 'x');
+
+		t.strictEqual(Type.getStaticName(1), 'true');
+		t.strictEqual(Type.getStaticName(0), 'false');
+		t.strictEqual(Type.getInternedName(1), 'true');
+		t.strictEqual(Type.getInternedName(1), 'true');
+
 		obj = new Type(0, 'quux');
 		t.strictEqual(Type.getStringStatic(), 'quux');
 		t.strictEqual(obj.getString(), 'quux');
@@ -190,6 +206,42 @@ test('Callbacks', function(t: any) {
 	t.end();
 });
 
+test('Callback queues', function(t: any) {
+	const Type = testModule.Callback;
+	const count = 1000;
+	let received: number[] = [];
+	let calls = 0;
+
+	function check() {
+		if(received.length < count) return;
+
+		Type.closeQueue();
+
+		received.sort(function(a: number, b: number) { return(a - b); });
+		t.strictEqual(received.join(), Array.apply(null, Array(count)).map(function(_: any, num: number) { return(num); }).join());
+
+		if(calls > 0) {
+			// Coalesced calls carry arrays of payloads.
+			t.ok(calls < count);
+			t.end();
+			return;
+		}
+
+		received = [];
+
+		Type.postFromThreads(function(payloadList: number[]) {
+			++calls;
+			received.push.apply(received, payloadList);
+			check();
+		}, 4, count, true);
+	}
+
+	Type.postFromThreads(function(payload: number) {
+		received.push(payload);
+		check();
+	}, 4, count, false);
+});
+
 test('Value objects', function(t: any) {
 	const Type = testModule.Value;
 
@@ -220,6 +272,9 @@ test('Value objects', function(t: any) {
 	t.strictEqual(xy.x, 60);
 	t.strictEqual(xy.y, 25);
 
+	t.strictEqual(Type.sumCoord(new Coord(10, 20), new Coord(30, 40)), 100);
+	t.strictEqual(Type.sumCoord(xy, new Coord(1, 2)), 88);
+
 	t.end();
 });
 
@@ -236,6 +291,7 @@ test('Pointers and references', function(t: any) {
 	const types = [ own, value, ptr, ref, constPtr, constRef ];
 
 	for(var i = 0; i < types.length; ++i) {
+		t.ok(types[i] instanceof Type);
 		t.type(Type.readPtr(types[i]!), 'undefined');
 		t.type(Type.readRef(types[i]!), 'undefined');
 
@@ -306,6 +362,37 @@ test('Arrays', function(t: any) {
 	t.end();
 });
 
+test('Typed arrays', function(t: any) {
+	const ArrayType = testModule.Array;
+	const VectorType = testModule.Vector;
+
+	t.strictEqual(VectorType.sumDoubles([0.5, 1.5, 2.5]), 4.5);
+	t.strictEqual(VectorType.sumDoubles(new Float64Array([0.5, 1.5, 2.5])), 4.5);
+
+	t.strictDeepEqual(VectorType.getDoubles(), [0.5, 1.5, 2.5]);
+
+	const doubles = VectorType.getDoublesTyped();
+
+	t.ok(doubles instanceof Float64Array);
+	t.strictDeepEqual(Array.prototype.slice.call(doubles), [0.5, 1.5, 2.5]);
+
+	const ints = ArrayType.getIntsTyped();
+
+	t.ok(ints instanceof Int32Array);
+	t.strictDeepEqual(Array.prototype.slice.call(ints), [13, 21, 34]);
+
+	t.strictDeepEqual(ArrayType.callWithInts(function(a: number[]) {
+		t.strictDeepEqual(a, [1, 2, 3]);
+		return(new Int32Array([4, 5, 6]));
+	}, new Int32Array([1, 2, 3])), [4, 5, 6]);
+
+	t.throws(function() {
+		ArrayType.callWithInts(function(a: number[]) {}, new Int32Array(2));
+	}, {message: 'Type mismatch'});
+
+	t.end();
+});
+
 test('Nullable', function(t: any) {
 	const Type = testModule.Nullable;
 
@@ -525,6 +612,305 @@ test('Buffers', function(t: any) {
 		t.strictEqual(Type.sum(buf), 240);
 	}
 
+	// Returned memory is handed over to JavaScript.
+
+	const results = [ Type.range(16), Type.rangeVector(16), Type.rangeString(16) ];
+
+	for(let i = 0; i < results.length; ++i) {
+		t.strictEqual(results[i].length, 16);
+		t.strictEqual(Type.sum(results[i]), 120);
+	}
+
+	t.strictEqual(Type.range(0).length, 0);
+	t.strictEqual(Type.rangeVector(0).length, 0);
+
+	t.end();
+});
+
+test('Spans', function(t: any) {
+	const Type = testModule.TypedView;
+
+	if(typeof(process) == 'object' && typeof(process.versions) == 'object' && process.versions.modules < 14) {
+		t.end();
+		return;
+	}
+
+	const doubles = new Float64Array([1, 2, 3, 4.5]);
+
+	t.strictEqual(Type.sum(doubles), 10.5);
+	t.strictEqual(Type.sum(doubles.subarray(1, 3)), 5);
+	t.strictEqual(Type.sum(doubles.buffer), 10.5);
+
+	t.throws(function() {
+		Type.sum(new Float32Array(4));
+	}, {message: 'Type mismatch'});
+
+	t.throws(function() {
+		Type.sum(new ArrayBuffer(12));
+	}, {message: 'Type mismatch'});
+
+	const floats = new Float32Array([1, 2, 3]);
+
+	Type.scale(floats, 2);
+
+	t.deepEqual(Array.prototype.slice.call(floats), [2, 4, 6]);
+
+	const obj = new Type(4);
+	const values = obj.getValues();
+
+	t.ok(values instanceof Float64Array);
+	t.strictEqual(values.length, 4);
+	t.strictEqual(values[3], 3);
+
+	// The typed array aliases memory inside the C++ object.
+
+	values[3] = 42;
+	t.strictEqual(obj.get(3), 42);
+
+	// Wrapping the same memory again gives another view of it.
+
+	const again = obj.getValues();
+
+	t.notEqual(again, values);
+	t.strictEqual(again[3], 42);
+
+	again[0] = 7;
+	t.strictEqual(values[0], 7);
+
+	t.end();
+});
+
+test('Arena', function(t: any) {
+	const Type = testModule.ArenaItem;
+	const count = Type.countLive();
+	let kept: testLib.ArenaItem | null = null;
+
+	const sum = binding.withArena(function() {
+		const a = new Type(1);
+		const b = new Type(2);
+
+		kept = a;
+		t.strictEqual(Type.countLive(), count + 2);
+
+		return(a.getValue() + b.getValue());
+	});
+
+	t.strictEqual(sum, 3);
+	t.strictEqual(Type.countLive(), count);
+
+	// Objects are destroyed even if their wrappers are still referenced.
+
+	t.throws(function() {
+		kept!.getValue();
+	});
+
+	t.end();
+});
+
+test('Scope', function(t: any) {
+	const Type = testModule.ArenaItem;
+	const count = Type.countLive();
+	let temp: testLib.ArenaItem | null = null;
+	let kept: testLib.ArenaItem | null = null;
+
+	const result = binding.scope(function() {
+		temp = new Type(1);
+		kept = new Type(2);
+		kept.persist!();
+
+		t.strictEqual(Type.countLive(), count + 2);
+
+		return(new Type(3));
+	});
+
+	// Temporaries are destroyed, the result and persistent objects kept.
+
+	t.strictEqual(Type.countLive(), count + 2);
+	t.strictEqual(result.getValue(), 3);
+	t.strictEqual(kept!.getValue(), 2);
+
+	t.throws(function() {
+		temp!.getValue();
+	});
+
+	result.free!();
+	kept!.free!();
+
+	t.strictEqual(Type.countLive(), count);
+
+	// Only the returned object itself is kept, not its contents.
+
+	const list = binding.scope(function() {
+		return([ new Type(4) ]);
+	});
+
+	t.strictEqual(list.length, 1);
+	t.strictEqual(Type.countLive(), count);
+
+	t.end();
+});
+
+test('Free', function(t: any) {
+	const Type = testModule.ArenaItem;
+	const count = Type.countLive();
+	const obj = new Type(1);
+
+	t.strictEqual(Type.countLive(), count + 1);
+
+	// The destructor runs at once, also for objects stored inline.
+
+	obj.free!();
+	t.strictEqual(Type.countLive(), count);
+
+	t.throws(function() {
+		obj.getValue();
+	});
+
+	t.end();
+});
+
+test('Class stats', function(t: any) {
+	if(!binding.classStats) {
+		t.end();
+		return;
+	}
+
+	const Type = testModule.ArenaItem;
+	const stats = binding.classStats();
+
+	t.type(Type, 'function');
+	t.ok(stats.ready > 0);
+	t.ok(stats.ready <= stats.total);
+
+	t.end();
+});
+
+test('Live objects', function(t: any) {
+	const Type = testModule.Smart;
+
+	function getStats() {
+		return(binding.liveObjects().filter(
+			(stats: nbind.LiveObjects) => stats.name == 'Smart'
+		)[0]);
+	}
+
+	const before = getStats();
+	const count = before ? before.shared : 0;
+
+	binding.sampleAllocations(1);
+	const obj = Type.make(42);
+	binding.sampleAllocations(0);
+
+	const stats = getStats();
+
+	t.strictEqual(stats.shared, count + 1);
+	t.ok(stats.bytes > 0);
+	t.ok(stats.sites.length > 0);
+
+	obj!.free!();
+
+	const after = getStats();
+
+	t.strictEqual(after ? after.shared : 0, count);
+
+	t.end();
+});
+
+test('Call stats', function(t: any) {
+	// Only available when compiled with NBIND_PROFILE.
+
+	if(!binding.stats) {
+		t.end();
+		return;
+	}
+
+	const Type = testModule.PrimitiveMethods;
+
+	for(let num = 0; num < 10; ++num) Type.strLengthStatic('foo');
+
+	const entry = binding.stats().filter(
+		(item: nbind.CallStats) => item.name == 'PrimitiveMethods.strLengthStatic'
+	)[0];
+
+	t.strictEqual(entry.calls, 10);
+	t.strictEqual(entry.exceptions, 0);
+	t.ok(entry.argTime + entry.bodyTime + entry.returnTime <= entry.time + 1);
+	t.strictEqual(entry.histogram.reduce((a: number, b: number) => a + b, 0), 10);
+
+	t.end();
+});
+
+test('Async', function(t: any) {
+	const Type = testModule.AsyncWork;
+	const obj = new Type(40);
+
+	(Type.sumTo(100) as any).then(function(sum: number) {
+		t.strictEqual(sum, 5050);
+
+		return(Type.repeat('ab', 3));
+	}).then(function(str: string) {
+		t.strictEqual(str, 'ababab');
+
+		return(obj.add(2));
+	}).then(function(result: number) {
+		t.strictEqual(result, 42);
+
+		return(Type.fail('Oops'));
+	}).then(function() {
+		t.fail('Exception should reject the promise');
+		t.end();
+	}, function(err: Error) {
+		t.strictEqual(err.message, 'Oops');
+		t.end();
+	});
+});
+
+test('Batch calls', function(t: any) {
+	var Type = testModule.PrimitiveMethods;
+	var obj = new Type(0);
+
+	var incrementStatic = Type.incrementIntStatic as any;
+	var increment = Type.prototype.incrementInt as any;
+	var strLength = Type.strLengthStatic as any;
+
+	function toArray(list: any) {
+		return(Array.prototype.slice.call(list));
+	}
+
+	// Numeric results are returned in typed arrays.
+
+	t.ok(incrementStatic.batch([1, 2, 3]) instanceof Int32Array);
+	t.deepEqual(toArray(incrementStatic.batch([1, 2, 3])), [2, 3, 4]);
+	t.deepEqual(toArray(incrementStatic.batch(new Int32Array([4, 5]))), [5, 6]);
+	t.deepEqual(toArray(increment.batch(obj, [1, 2, 3])), [2, 3, 4]);
+	t.deepEqual(toArray(strLength.batch(['foo', 'quux'])), [3, 4]);
+	t.strictEqual(incrementStatic.batch([]).length, 0);
+
+	t.deepEqual(toArray((testModule.multiTest2 as any).batch([0, 0], new Uint32Array([0, 0]))), [2, 2]);
+
+	// Other results are returned in plain arrays.
+
+	t.deepEqual((Type.negateStatic as any).batch([true, false]), [false, true]);
+	t.deepEqual((testModule.StrictStatic.testString as any).batch(['a', 'b']), ['a', 'b']);
+
+	// Any mismatch in a column fails the whole batch.
+
+	t.throws(function() {
+		(testModule.StrictStatic.strictInt as any).batch([1, 'foo', 3]);
+	}, {message: 'Type mismatch'});
+
+	t.throws(function() {
+		(testModule.StrictStatic.strictString as any).batch(new Int32Array([1, 2]));
+	}, {message: 'Type mismatch'});
+
+	t.throws(function() {
+		(testModule.multiTest2 as any).batch([1, 2], [3]);
+	});
+
+	t.throws(function() {
+		(Type.getStateStatic as any).batch();
+	});
+
 	t.end();
 });
 